@@ -0,0 +1,2623 @@
+#include "Utils/CellList.hpp"
+#include "Utils/SceneOccupancy.hpp"
+#include "Utils/Polygon2D.hpp"
+#include "Utils/Geometry.hpp"
+#include "Utils/Grid.hpp"
+#include "Utils/PseudoRandom.hpp"
+#include "Utils/Timer.hpp"
+#include "Utils/PrintMsg.hpp"
+#include "Utils/Constants.hpp"
+#include "Utils/Misc.hpp"
+#include "Utils/Parallel.hpp"
+#include "Utils/Map.hpp"
+#include "Utils/GraphSearch.hpp"
+#include "Utils/DenseGraphSearch.hpp"
+#include "Utils/Heap.hpp"
+#include "Utils/DaryHeap.hpp"
+#include "Utils/BucketQueue.hpp"
+#include "Utils/GridSearchInfo.hpp"
+#include "Utils/JumpPointSearch.hpp"
+#include "Utils/DStarLite.hpp"
+#include "Utils/FlowField.hpp"
+#include "Utils/LandmarkSearchInfo.hpp"
+#include "Utils/CSRGraph.hpp"
+#include "Utils/DeltaStepping.hpp"
+#include "Utils/ContractionHierarchy.hpp"
+#include "Utils/CSRSearchInfo.hpp"
+#include "Utils/ThetaStar.hpp"
+#include "Utils/PRM.hpp"
+#include "Utils/KDTree2D.hpp"
+#include "Utils/PRMSamplers.hpp"
+#include "Utils/QuasiRandom.hpp"
+#include "Utils/Quadtree2D.hpp"
+#include "Utils/Quadtree2DSearchInfo.hpp"
+#include "Utils/SparseGrid.hpp"
+#include "Utils/OccupancyPyramid2D.hpp"
+#include <vector>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <map>
+#include <algorithm>
+#include <unordered_map>
+
+using namespace Abetare;
+
+static bool ReadScene(const char fname[], std::vector<Polygon2D*> * const polys, double bbox[4])
+{
+    FILE *in = fopen(fname, "r");
+    std::vector< std::vector<double>* > vertices;
+
+    if(in == NULL)
+    {
+	PrintError(printf("could not open <%s>\n", fname));
+	return false;
+    }
+    ReadPolygons2D(in, &vertices);
+    fclose(in);
+
+    bbox[0] = bbox[1] =  HUGE_VAL;
+    bbox[2] = bbox[3] = -HUGE_VAL;
+    for(int i = 0; i < (int) vertices.size(); ++i)
+    {
+	Polygon2D *poly = new Polygon2D();
+
+	poly->m_vertices = *(vertices[i]);
+	poly->MakeCCW();
+	polys->push_back(poly);
+
+	const double *pbox = poly->GetBoundingBox();
+	for(int j = 0; j < 2; ++j)
+	{
+	    if(pbox[j] < bbox[j])
+		bbox[j] = pbox[j];
+	    if(pbox[2 + j] > bbox[2 + j])
+		bbox[2 + j] = pbox[2 + j];
+	}
+    }
+    DeleteItems< std::vector<double>* >(&vertices);
+
+    return true;
+}
+
+extern "C" int BenchmarkCellList(int argc, char **argv)
+{
+    const int    n      = argc > 1 ? atoi(argv[1]) : 4000;
+    const double r      = argc > 2 ? atof(argv[2]) : 2.0;
+    const int    nsteps = argc > 3 ? atoi(argv[3]) : 10;
+    const int    k      = 7;
+    const double size   = 100;
+
+    std::vector<double> pts(2 * n);
+    std::vector<int>    neighs;
+    std::vector<int>    knn;
+    Grid                grid;
+    CellList            clist;
+    Timer::Clock        clk;
+    double              tcell  = 0;
+    double              tbrute = 0;
+    long                ncell  = 0;
+    long                nbrute = 0;
+    int                 nerrs  = 0;
+
+    //cells with sides equal to the query radius keep each query to 3x3 cells
+    const int dims = (int) (size / r) < 1 ? 1 : (int) (size / r);
+    grid.Setup2D(dims, dims, 0, 0, size, size);
+    clist.Setup(&grid);
+
+    for(int i = 0; i < 2 * n; ++i)
+	pts[i] = RandomUniformReal(0, size);
+
+    for(int s = 0; s < nsteps; ++s)
+    {
+	//move the agents a little, as a simulation step would
+	for(int i = 0; i < 2 * n; ++i)
+	{
+	    pts[i] += RandomUniformReal(-0.5, 0.5);
+	    pts[i] = pts[i] < 0 ? 0 : (pts[i] > size ? size : pts[i]);
+	}
+
+	Timer::Start(&clk);
+	clist.Rebuild(n, &pts[0]);
+	for(int i = 0; i < n; ++i)
+	{
+	    neighs.clear();
+	    clist.GetNeighsInRadius(&pts[2 * i], r, &neighs, i);
+	    ncell += neighs.size();
+	}
+	tcell += Timer::Elapsed(&clk);
+
+	Timer::Start(&clk);
+	for(int i = 0; i < n; ++i)
+	    for(int j = 0; j < n; ++j)
+		if(j != i &&
+		   (pts[2 * i] - pts[2 * j]) * (pts[2 * i] - pts[2 * j]) +
+		   (pts[2 * i + 1] - pts[2 * j + 1]) * (pts[2 * i + 1] - pts[2 * j + 1]) <= r * r)
+		    ++nbrute;
+	tbrute += Timer::Elapsed(&clk);
+
+	//spot check the k-nearest query against a linear scan
+	for(int i = 0; i < n; i += 97)
+	{
+	    std::vector<double> dists;
+	    int                 nless = 0;
+
+	    knn.clear();
+	    clist.GetKNearest(&pts[2 * i], k, &knn, &dists, i);
+	    for(int j = 0; j < n; ++j)
+		if(j != i &&
+		   (pts[2 * i] - pts[2 * j]) * (pts[2 * i] - pts[2 * j]) +
+		   (pts[2 * i + 1] - pts[2 * j + 1]) * (pts[2 * i + 1] - pts[2 * j + 1]) <
+		   (1 - Constants::SQRT_EPSILON) * dists.back() * dists.back())
+		    ++nless;
+	    if((int) knn.size() != (k < n - 1 ? k : n - 1) || nless >= k)
+		++nerrs;
+	}
+    }
+
+    printf("agents=%d radius=%f steps=%d\n", n, r, nsteps);
+    printf("cell list  : %f s (%ld neighbors)\n", tcell, ncell);
+    printf("brute force: %f s (%ld neighbors)\n", tbrute, nbrute);
+    if(ncell != nbrute || nerrs > 0)
+    {
+	PrintError(printf("results differ (knn errors = %d)\n", nerrs));
+	return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Count the cells whose obstacle lists or inside flags differ between
+ * the two occupancies
+ */
+static int BenchmarkSceneOccupancyCompare(const SceneOccupancy & occ1, const SceneOccupancy & occ2)
+{
+    int nerrs = 0;
+
+    for(int id = 0; id < occ1.GetGrid()->GetNrCells(); ++id)
+    {
+	int        n1, n2;
+	const int *obst1 = occ1.GetCellObstacles(id, &n1);
+	const int *obst2 = occ2.GetCellObstacles(id, &n2);
+
+	if(n1 != n2 || !std::equal(obst1, obst1 + n1, obst2) || occ1.IsInside(id) != occ2.IsInside(id))
+	    ++nerrs;
+    }
+
+    return nerrs;
+}
+
+/*
+ * SceneOccupancy on 1 and on nrThreads threads, whose per-cell obstacle
+ * lists and inside flags must both match a sequential merge of
+ * Polygon2D::OccupiedGridCells
+ */
+extern "C" int BenchmarkSceneOccupancy(int argc, char **argv)
+{
+    std::vector<Polygon2D*> polys;
+    double                  bbox[4];
+    Grid                    grid;
+    SceneOccupancy          occ1;
+    SceneOccupancy          occn;
+    Timer::Clock            clk;
+    int                     nerrs = 0;
+
+    if(argc < 2)
+    {
+	PrintWarning(printf("usage: BenchmarkSceneOccupancy <map> [dims] [nrThreads]\n"));
+	return 1;
+    }
+    if(!ReadScene(argv[1], &polys, bbox))
+	return 1;
+
+    const int dims     = argc > 2 ? atoi(argv[2]) : 1000;
+    const int nthreads = argc > 3 ? atoi(argv[3]) : GetNrHardwareThreads();
+
+    grid.Setup2D(dims, dims, bbox[0], bbox[1], bbox[2], bbox[3]);
+
+    Timer::Start(&clk);
+    occ1.Compute(&grid, polys.size(), polys.data(), 1);
+    const double t1 = Timer::Elapsed(&clk);
+
+    Timer::Start(&clk);
+    occn.Compute(&grid, polys.size(), polys.data(), nthreads);
+    const double tn = Timer::Elapsed(&clk);
+
+    //sequential reference: obstacles in increasing order in each cell
+    std::vector< std::vector<int> > lists(grid.GetNrCells());
+    std::vector<char>               inside(grid.GetNrCells(), 0);
+    std::vector<int>                cinside, cintersect;
+
+    Timer::Start(&clk);
+    for(int i = 0; i < (int) polys.size(); ++i)
+    {
+	polys[i]->OccupiedGridCells(&grid, &cinside, &cintersect);
+	for(int j = 0; j < (int) cinside.size(); ++j)
+	{
+	    lists[cinside[j]].push_back(i);
+	    inside[cinside[j]] = 1;
+	}
+	for(int j = 0; j < (int) cintersect.size(); ++j)
+	    lists[cintersect[j]].push_back(i);
+    }
+    const double tref = Timer::Elapsed(&clk);
+
+    for(int id = 0; id < grid.GetNrCells(); ++id)
+    {
+	int        n;
+	const int *obst = occ1.GetCellObstacles(id, &n);
+
+	if(n != (int) lists[id].size() || !std::equal(obst, obst + n, lists[id].begin()) ||
+	   occ1.IsInside(id) != (inside[id] != 0))
+	    ++nerrs;
+    }
+    nerrs += BenchmarkSceneOccupancyCompare(occ1, occn);
+
+    printf("map=%s obstacles=%d grid=%dx%d\n", argv[1], (int) polys.size(), dims, dims);
+    printf("sequential: %f s\n", tref);
+    printf("1 thread  : %f s (%d occupied cells)\n", t1, occ1.GetNrOccupiedCells());
+    printf("%d threads: %f s (%d occupied cells)\n", nthreads, tn, occn.GetNrOccupiedCells());
+
+    DeleteItems<Polygon2D*>(&polys);
+
+    if(nerrs > 0)
+    {
+	PrintError(printf("%d cells differ\n", nerrs));
+	return 1;
+    }
+
+    return 0;
+}
+
+struct BenchmarkMapKey
+{
+    int m_x;
+    int m_y;
+
+    bool operator==(const BenchmarkMapKey & other) const
+    {
+	return m_x == other.m_x && m_y == other.m_y;
+    }
+
+    bool operator<(const BenchmarkMapKey & other) const
+    {
+	return m_x < other.m_x || (m_x == other.m_x && m_y < other.m_y);
+    }
+};
+
+struct BenchmarkMapKeyHash
+{
+    size_t operator()(const BenchmarkMapKey & key) const
+    {
+	return MapHash<BenchmarkMapKey>::Hash(key);
+    }
+};
+
+template <typename Key>
+static Key BenchmarkMapMakeKey(const int i);
+
+template <>
+int BenchmarkMapMakeKey<int>(const int i)
+{
+    return i;
+}
+
+template <>
+BenchmarkMapKey BenchmarkMapMakeKey<BenchmarkMapKey>(const int i)
+{
+    BenchmarkMapKey key;
+    key.m_x = i % 1024;
+    key.m_y = i / 1024;
+    return key;
+}
+
+/*
+ * Each round inserts the keys, looks each of them up along with a key
+ * that is absent, removes half of them and clears the map, which is
+ * how searches use it. Returns 1 if the maps disagree, 0 otherwise.
+ */
+template <typename Key, typename StdMap>
+static int BenchmarkMapRun(const char name[], const std::vector<int> & ids, const int nrRounds)
+{
+    MapDefault<Key, int> map;
+    StdMap               smap;
+    Timer::Clock         clk;
+    const int            n     = ids.size();
+    long                 found  = 0;
+    long                 sfound = 0;
+    bool                 had;
+
+    Timer::Start(&clk);
+    for(int r = 0; r < nrRounds; ++r)
+    {
+	map.Clear();
+	for(int i = 0; i < n; ++i)
+	    map.Insert(BenchmarkMapMakeKey<Key>(ids[i]), i);
+	for(int i = 0; i < n; ++i)
+	{
+	    found += map.GetData(BenchmarkMapMakeKey<Key>(ids[i]), -1, &had) >= 0;
+	    found += map.HasKey(BenchmarkMapMakeKey<Key>(ids[i] + 1));
+	}
+	for(int i = 0; i < n; i += 2)
+	    map.Remove(BenchmarkMapMakeKey<Key>(ids[i]));
+    }
+    const double t = Timer::Elapsed(&clk);
+
+    Timer::Start(&clk);
+    for(int r = 0; r < nrRounds; ++r)
+    {
+	smap.clear();
+	for(int i = 0; i < n; ++i)
+	    smap[BenchmarkMapMakeKey<Key>(ids[i])] = i;
+	for(int i = 0; i < n; ++i)
+	{
+	    sfound += smap.find(BenchmarkMapMakeKey<Key>(ids[i])) != smap.end();
+	    sfound += smap.find(BenchmarkMapMakeKey<Key>(ids[i] + 1)) != smap.end();
+	}
+	for(int i = 0; i < n; i += 2)
+	    smap.erase(BenchmarkMapMakeKey<Key>(ids[i]));
+    }
+    const double ts = Timer::Elapsed(&clk);
+
+    const bool same = found == sfound && map.GetNrKeys() == (int) smap.size();
+
+    printf("%-28s: MapDefault %f s, std %f s%s\n", name, t, ts, same ? "" : " (results differ)");
+
+    return same ? 0 : 1;
+}
+
+extern "C" int BenchmarkMap(int argc, char **argv)
+{
+    const int        n        = argc > 1 ? atoi(argv[1]) : 100000;
+    const int        nrRounds = argc > 2 ? atoi(argv[2]) : 20;
+    std::vector<int> ids(n);
+    int              nerrs    = 0;
+
+    //even ids, so that id + 1 is never in the map
+    for(int i = 0; i < n; ++i)
+	ids[i] = 2 * i;
+    PermuteItems<int>(&ids, n);
+
+    printf("keys=%d rounds=%d\n", n, nrRounds);
+    nerrs += BenchmarkMapRun< int, std::map<int, int> >("int vs std::map", ids, nrRounds);
+    nerrs += BenchmarkMapRun< int, std::unordered_map<int, int> >("int vs std::unordered_map", ids, nrRounds);
+    nerrs += BenchmarkMapRun< BenchmarkMapKey, std::map<BenchmarkMapKey, int> >
+	("struct vs std::map", ids, nrRounds);
+    nerrs += BenchmarkMapRun< BenchmarkMapKey, std::unordered_map<BenchmarkMapKey, int, BenchmarkMapKeyHash> >
+	("struct vs std::unordered_map", ids, nrRounds);
+
+    if(nerrs > 0)
+    {
+	PrintError(printf("results differ in %d runs\n", nerrs));
+	return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Occupancy grid of the obstacles in the map
+ */
+static bool ReadGridScene(const char fname[], const int dims, Grid * const grid, GridSearchInfo * const info)
+{
+    std::vector<Polygon2D*> polys;
+    double                  bbox[4];
+    SceneOccupancy          occ;
+
+    if(!ReadScene(fname, &polys, bbox))
+	return false;
+
+    grid->Setup2D(dims, dims, bbox[0], bbox[1], bbox[2], bbox[3]);
+    occ.Compute(grid, polys.size(), polys.data());
+
+    bool *occupied = new bool[grid->GetNrCells()];
+    occ.GetOccupied(occupied);
+    info->Setup(grid, occupied);
+    delete[] occupied;
+
+    DeleteItems<Polygon2D*>(&polys);
+
+    return true;
+}
+
+static void RandomStartAndGoal(GridSearchInfo * const info)
+{
+    const int n = info->GetDimX() * info->GetDimY();
+    int       start, goal;
+
+    do
+    {
+	start = RandomUniformInteger(0, n - 1);
+	goal  = RandomUniformInteger(0, n - 1);
+    }
+    while(info->IsOccupied(start) || info->IsOccupied(goal));
+
+    info->SetStart(start);
+    info->SetGoal(goal);
+}
+
+extern "C" int BenchmarkGraphSearch(int argc, char **argv)
+{
+    const int         dims      = argc > 1 ? atoi(argv[1]) : 1000;
+    const int         nrQueries = argc > 2 ? atoi(argv[2]) : 10;
+    const double      density   = argc > 3 ? atof(argv[3]) : 0.25;
+    Grid              grid;
+    GridSearchInfo    info;
+    GraphSearch<int>  gsearch;
+    DenseGraphSearch  dsearch;
+    Timer::Clock      clk;
+    double            tmap      = 0;
+    double            tdense    = 0;
+    int               nerrs     = 0;
+    int               goal;
+
+    grid.Setup2D(dims, dims, 0, 0, dims, dims);
+
+    bool *occupied = new bool[dims * dims];
+    for(int i = 0; i < dims * dims; ++i)
+	occupied[i] = RandomUniformReal(0, 1) < density;
+    info.Setup(&grid, occupied);
+    delete[] occupied;
+
+    gsearch.m_info = &info;
+    dsearch.m_info = &info;
+    dsearch.Setup(dims * dims);
+
+    for(int q = 0; q < nrQueries; ++q)
+    {
+	RandomStartAndGoal(&info);
+
+	Timer::Start(&clk);
+	const bool   found = gsearch.AStar(info.GetStart(), false, &goal);
+	tmap += Timer::Elapsed(&clk);
+	const double cost  = found ? gsearch.GetPathCostFromStart(goal) : HUGE_VAL;
+
+	Timer::Start(&clk);
+	const bool   dfound = dsearch.AStar(info.GetStart(), false, &goal);
+	tdense += Timer::Elapsed(&clk);
+	const double dcost  = dfound ? dsearch.GetPathCostFromStart(goal) : HUGE_VAL;
+
+	if(found != dfound || (found && fabs(cost - dcost) > Constants::SQRT_EPSILON))
+	    ++nerrs;
+    }
+
+    printf("grid=%dx%d queries=%d density=%f\n", dims, dims, nrQueries, density);
+    printf("GraphSearch     : %f s\n", tmap);
+    printf("DenseGraphSearch: %f s\n", tdense);
+    if(nerrs > 0)
+    {
+	PrintError(printf("path costs differ in %d queries\n", nerrs));
+	return 1;
+    }
+
+    return 0;
+}
+
+static bool BenchmarkHeapLessFn(const int u, const int v, const std::vector<double> * dists)
+{
+    return (*dists)[u] < (*dists)[v];
+}
+
+/*
+ * Dijkstra on a 4-connected grid with integer cell costs in [1, 9]
+ */
+template <typename Queue>
+static double BenchmarkHeapDijkstra(const int dims, const std::vector<int> & weights,
+				    Queue * const queue, std::vector<double> * const dists)
+{
+    Timer::Clock clk;
+    const int    dx[4] = {1, -1, 0, 0};
+    const int    dy[4] = {0, 0, 1, -1};
+
+    Timer::Start(&clk);
+    dists->assign(dims * dims, HUGE_VAL);
+    (*dists)[0] = 0;
+    queue->Insert(0, 0);
+    while(!queue->IsEmpty())
+    {
+	const int u = queue->RemoveTop();
+	const int x = u % dims;
+	const int y = u / dims;
+
+	for(int k = 0; k < 4; ++k)
+	{
+	    const int nx = x + dx[k];
+	    const int ny = y + dy[k];
+
+	    if(nx >= 0 && ny >= 0 && nx < dims && ny < dims)
+	    {
+		const int    v = ny * dims + nx;
+		const double d = (*dists)[u] + weights[v];
+
+		if(d < (*dists)[v])
+		{
+		    (*dists)[v] = d;
+		    queue->InsertOrUpdate(v, (int) d);
+		}
+	    }
+	}
+    }
+    return Timer::Elapsed(&clk);
+}
+
+/*
+ * Adapts Heap, whose comparisons look up costs through a function
+ * pointer and whose positions are kept in a map
+ */
+class BenchmarkHeapAdapter
+{
+public:
+    Heap<int, const std::vector<double>*> m_heap;
+
+    bool IsEmpty(void) const
+    {
+	return m_heap.IsEmpty();
+    }
+
+    int RemoveTop(void)
+    {
+	return m_heap.RemoveTop();
+    }
+
+    void Insert(const int key, const double cost)
+    {
+	m_heap.Insert(key);
+    }
+
+    void InsertOrUpdate(const int key, const double cost)
+    {
+	if(m_heap.HasKey(key))
+	    m_heap.Update(key);
+	else
+	    m_heap.Insert(key);
+    }
+};
+
+extern "C" int BenchmarkHeap(int argc, char **argv)
+{
+    const int            dims = argc > 1 ? atoi(argv[1]) : 1000;
+    std::vector<int>     weights(dims * dims);
+    std::vector<double>  dists[4];
+    BenchmarkHeapAdapter heap;
+    DaryHeap<2>          heap2;
+    DaryHeap<4>          heap4;
+    BucketQueue          bqueue;
+
+    for(int i = 0; i < dims * dims; ++i)
+	weights[i] = RandomUniformInteger(1, 9);
+
+    heap.m_heap.m_lessFn     = BenchmarkHeapLessFn;
+    heap.m_heap.m_lessFnData = &(dists[0]);
+    heap2.Setup(dims * dims);
+    heap4.Setup(dims * dims);
+    bqueue.Setup(dims * dims, 10);
+
+    printf("grid=%dx%d\n", dims, dims);
+    printf("Heap        : %f s\n", BenchmarkHeapDijkstra(dims, weights, &heap, &(dists[0])));
+    printf("DaryHeap<2> : %f s\n", BenchmarkHeapDijkstra(dims, weights, &heap2, &(dists[1])));
+    printf("DaryHeap<4> : %f s\n", BenchmarkHeapDijkstra(dims, weights, &heap4, &(dists[2])));
+    printf("BucketQueue : %f s\n", BenchmarkHeapDijkstra(dims, weights, &bqueue, &(dists[3])));
+
+    for(int i = 1; i < 4; ++i)
+	if(dists[i] != dists[0])
+	{
+	    PrintError(printf("distances differ\n"));
+	    return 1;
+	}
+
+    return 0;
+}
+
+extern "C" int BenchmarkBidirectionalAStar(int argc, char **argv)
+{
+    Grid             grid;
+    GridSearchInfo   info;
+    GraphSearch<int> gsearch;
+    Timer::Clock     clk;
+    double           tuni  = 0;
+    double           tbi   = 0;
+    long             nruni = 0;
+    long             nrbi  = 0;
+    int              nerrs = 0;
+    int              goal;
+
+    if(argc < 2)
+    {
+	PrintWarning(printf("usage: BenchmarkBidirectionalAStar <map> [dims] [nrQueries]\n"));
+	return 1;
+    }
+
+    const int dims      = argc > 2 ? atoi(argv[2]) : 300;
+    const int nrQueries = argc > 3 ? atoi(argv[3]) : 50;
+
+    if(!ReadGridScene(argv[1], dims, &grid, &info))
+	return 1;
+    gsearch.m_info = &info;
+
+    for(int q = 0; q < nrQueries; ++q)
+    {
+	RandomStartAndGoal(&info);
+
+	Timer::Start(&clk);
+	const bool   found = gsearch.AStar(info.GetStart(), false, &goal);
+	tuni  += Timer::Elapsed(&clk);
+	nruni += gsearch.GetNrExpansions();
+	const double cost  = found ? gsearch.GetPathCostFromStart(goal) : HUGE_VAL;
+
+	Timer::Start(&clk);
+	const bool   bfound = gsearch.BidirectionalAStar(info.GetStart(), info.GetGoal());
+	tbi  += Timer::Elapsed(&clk);
+	nrbi += gsearch.GetNrExpansions();
+	const double bcost  = bfound ? gsearch.GetPathCostFromStart(info.GetGoal()) : HUGE_VAL;
+
+	std::vector<int> path;
+	gsearch.GetPathFromStart(info.GetGoal(), &path);
+	if(found != bfound || (found && (fabs(cost - bcost) > Constants::SQRT_EPSILON ||
+					 path.front() != info.GetStart() || path.back() != info.GetGoal())))
+	    ++nerrs;
+    }
+
+    printf("map=%s grid=%dx%d queries=%d\n", argv[1], dims, dims, nrQueries);
+    printf("A*              : %f s (%ld expansions)\n", tuni, nruni);
+    printf("bidirectional A*: %f s (%ld expansions)\n", tbi, nrbi);
+    if(nerrs > 0)
+    {
+	PrintError(printf("results differ in %d queries\n", nerrs));
+	return 1;
+    }
+
+    return 0;
+}
+
+extern "C" int BenchmarkJumpPointSearch(int argc, char **argv)
+{
+    Grid             grid;
+    GridSearchInfo   info;
+    DenseGraphSearch dsearch;
+    JumpPointSearch  jps;
+    Timer::Clock     clk;
+    double           tastar  = 0;
+    double           tjps    = 0;
+    long             nrastar = 0;
+    long             nrjps   = 0;
+    int              nerrs   = 0;
+    int              goal;
+
+    if(argc < 2)
+    {
+	PrintWarning(printf("usage: BenchmarkJumpPointSearch <map> [dims] [nrQueries]\n"));
+	return 1;
+    }
+
+    const int dims      = argc > 2 ? atoi(argv[2]) : 1000;
+    const int nrQueries = argc > 3 ? atoi(argv[3]) : 20;
+
+    if(!ReadGridScene(argv[1], dims, &grid, &info))
+	return 1;
+    dsearch.m_info = &info;
+    dsearch.Setup(grid.GetNrCells());
+    jps.Setup(&info);
+
+    for(int q = 0; q < nrQueries; ++q)
+    {
+	RandomStartAndGoal(&info);
+
+	Timer::Start(&clk);
+	const bool   found = dsearch.AStar(info.GetStart(), false, &goal);
+	tastar  += Timer::Elapsed(&clk);
+	nrastar += dsearch.GetNrExpansions();
+	const double cost  = found ? dsearch.GetPathCostFromStart(goal) : HUGE_VAL;
+
+	Timer::Start(&clk);
+	const bool   jfound = jps.Search(info.GetStart(), info.GetGoal());
+	tjps  += Timer::Elapsed(&clk);
+	nrjps += jps.GetNrExpansions();
+	const double jcost  = jfound ? jps.GetPathCostFromStart(info.GetGoal()) : HUGE_VAL;
+
+	//the full path must be made of valid moves and add up to the cost
+	std::vector<int> path;
+	double           plen = 0;
+
+	jps.GetPathFromStart(info.GetGoal(), &path);
+	for(int i = 1; i < (int) path.size(); ++i)
+	{
+	    std::vector<int>    edges;
+	    std::vector<double> costs;
+	    int                 j = 0;
+
+	    info.GetOutEdges(path[i - 1], &edges, &costs);
+	    while(j < (int) edges.size() && edges[j] != path[i])
+		++j;
+	    plen += j < (int) edges.size() ? costs[j] : HUGE_VAL;
+	}
+
+	if(found != jfound || (found && (fabs(cost - jcost) > Constants::SQRT_EPSILON ||
+					 fabs(cost - plen) > Constants::SQRT_EPSILON)))
+	    ++nerrs;
+    }
+
+    printf("map=%s grid=%dx%d queries=%d\n", argv[1], dims, dims, nrQueries);
+    printf("A*  : %f s (%ld expansions)\n", tastar, nrastar);
+    printf("JPS : %f s (%ld expansions)\n", tjps, nrjps);
+    if(nerrs > 0)
+    {
+	PrintError(printf("results differ in %d queries\n", nerrs));
+	return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * An agent walks along its path and, every few steps, a square
+ * obstacle appears on the path ahead of it. D* Lite repairs its
+ * search tree while A* searches again from scratch.
+ */
+extern "C" int BenchmarkDStarLite(int argc, char **argv)
+{
+    Grid             grid;
+    GridSearchInfo   info;
+    DenseGraphSearch dsearch;
+    DStarLite<int>   dstar;
+    Timer::Clock     clk;
+    double           tastar  = 0;
+    double           tdstar  = 0;
+    long             nrastar = 0;
+    long             nrdstar = 0;
+    int              nrsteps = 0;
+    int              nerrs   = 0;
+    int              goal;
+
+    if(argc < 2)
+    {
+	PrintWarning(printf("usage: BenchmarkDStarLite <map> [dims] [nrRuns] [blockEvery]\n"));
+	return 1;
+    }
+
+    const int dims       = argc > 2 ? atoi(argv[2]) : 300;
+    const int nrRuns     = argc > 3 ? atoi(argv[3]) : 5;
+    const int blockEvery = argc > 4 ? atoi(argv[4]) : 5;
+    const int half       = 2;
+
+    if(!ReadGridScene(argv[1], dims, &grid, &info))
+	return 1;
+    dsearch.m_info = &info;
+    dsearch.Setup(grid.GetNrCells());
+    dstar.m_info = &info;
+
+    for(int r = 0; r < nrRuns; ++r)
+    {
+	std::vector<int> path;
+
+	RandomStartAndGoal(&info);
+	Timer::Start(&clk);
+	dstar.Initialize(info.GetStart(), info.GetGoal());
+	dstar.ComputeShortestPath();
+	tdstar += Timer::Elapsed(&clk);
+
+	for(int s = 1; info.GetStart() != info.GetGoal(); ++s)
+	{
+	    path.clear();
+	    dstar.GetPathFromStart(&path);
+	    if(path.size() < 2)
+		break;
+
+	    //move one cell along the path
+	    info.SetStart(path[1]);
+	    dstar.MoveStart(path[1]);
+
+	    //block a square ahead of the agent, away from the start and goal
+	    if(s % blockEvery == 0 && (int) path.size() > 4 * half + 2)
+	    {
+		const int c  = path[2 * half + 1];
+		const int cx = c % dims;
+		const int cy = c / dims;
+
+		for(int y = cy - half; y <= cy + half; ++y)
+		    for(int x = cx - half; x <= cx + half; ++x)
+			if(x >= 0 && y >= 0 && x < dims && y < dims &&
+			   y * dims + x != info.GetStart() && y * dims + x != info.GetGoal())
+			    info.SetOccupied(y * dims + x, true);
+
+		Timer::Start(&clk);
+		for(int y = cy - half - 1; y <= cy + half + 1; ++y)
+		    for(int x = cx - half - 1; x <= cx + half + 1; ++x)
+			if(x >= 0 && y >= 0 && x < dims && y < dims)
+			    dstar.NotifyOutEdgesChanged(y * dims + x);
+		tdstar += Timer::Elapsed(&clk);
+	    }
+
+	    Timer::Start(&clk);
+	    const bool   found = dstar.ComputeShortestPath();
+	    tdstar += Timer::Elapsed(&clk);
+	    const double cost  = found ? dstar.GetPathCostFromStart() : HUGE_VAL;
+
+	    Timer::Start(&clk);
+	    const bool   afound = dsearch.AStar(info.GetStart(), false, &goal);
+	    tastar  += Timer::Elapsed(&clk);
+	    nrastar += dsearch.GetNrExpansions();
+	    const double acost  = afound ? dsearch.GetPathCostFromStart(goal) : HUGE_VAL;
+
+	    ++nrsteps;
+	    if(found != afound || (found && fabs(cost - acost) > Constants::SQRT_EPSILON))
+		++nerrs;
+	    if(!found)
+		break;
+	}
+	nrdstar += dstar.GetNrExpansions();
+    }
+
+    printf("map=%s grid=%dx%d runs=%d replans=%d\n", argv[1], dims, dims, nrRuns, nrsteps);
+    printf("A* from scratch: %f s (%ld expansions)\n", tastar, nrastar);
+    printf("D* Lite        : %f s (%ld expansions)\n", tdstar, nrdstar);
+    if(nerrs > 0)
+    {
+	PrintError(printf("path costs differ in %d replans\n", nerrs));
+	return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Agents from random cells heading to a shared goal: one flow field
+ * serves all of them, while A* runs once per agent.
+ */
+extern "C" int BenchmarkFlowField(int argc, char **argv)
+{
+    Grid             grid;
+    GridSearchInfo   info;
+    DenseGraphSearch dsearch;
+    FlowField        field;
+    Timer::Clock     clk;
+    double           tastar = 0;
+    double           tfield = 0;
+    int              nerrs  = 0;
+    int              goal;
+
+    if(argc < 2)
+    {
+	PrintWarning(printf("usage: BenchmarkFlowField <map> [dims] [nrAgents]\n"));
+	return 1;
+    }
+
+    const int dims     = argc > 2 ? atoi(argv[2]) : 300;
+    const int nrAgents = argc > 3 ? atoi(argv[3]) : 100;
+
+    if(!ReadGridScene(argv[1], dims, &grid, &info))
+	return 1;
+    dsearch.m_info = &info;
+    dsearch.Setup(grid.GetNrCells());
+    field.m_info = &info;
+    field.Setup(grid.GetNrCells());
+
+    RandomStartAndGoal(&info);
+
+    Timer::Start(&clk);
+    field.Compute(info.GetGoal());
+    field.ComputeDirections(&grid);
+    tfield += Timer::Elapsed(&clk);
+
+    for(int a = 0; a < nrAgents; ++a)
+    {
+	int start;
+
+	do
+	    start = RandomUniformInteger(0, grid.GetNrCells() - 1);
+	while(info.IsOccupied(start));
+	info.SetStart(start);
+
+	Timer::Start(&clk);
+	const bool   found = dsearch.AStar(start, false, &goal);
+	tastar += Timer::Elapsed(&clk);
+	const double cost  = found ? dsearch.GetPathCostFromStart(goal) : HUGE_VAL;
+
+	//following the field must reach the goal at the same cost
+	std::vector<int> path;
+	double           plen = 0;
+
+	Timer::Start(&clk);
+	field.GetPathToGoal(start, &path);
+	tfield += Timer::Elapsed(&clk);
+	for(int i = 1; i < (int) path.size(); ++i)
+	{
+	    double c1[2], c2[2], dir[2];
+
+	    grid.GetCellCenterFromId(path[i - 1], c1);
+	    grid.GetCellCenterFromId(path[i], c2);
+	    field.GetDirection(c1, dir);
+	    plen += info.OctileDistance(path[i - 1], path[i]);
+	    if(fabs(dir[0] * (c2[1] - c1[1]) - dir[1] * (c2[0] - c1[0])) > Constants::SQRT_EPSILON)
+		++nerrs;
+	}
+
+	if(found != field.CanReachGoal(start) ||
+	   (found && (fabs(cost - field.GetCostToGoal(start)) > Constants::SQRT_EPSILON ||
+		      fabs(cost - plen) > Constants::SQRT_EPSILON)))
+	    ++nerrs;
+    }
+
+    printf("map=%s grid=%dx%d agents=%d\n", argv[1], dims, dims, nrAgents);
+    printf("A* per agent : %f s\n", tastar);
+    printf("flow field   : %f s\n", tfield);
+    if(nerrs > 0)
+    {
+	PrintError(printf("results differ for %d agents\n", nerrs));
+	return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Repeated queries over the same grid, guided by the octile distance
+ * or by the landmarks together with it
+ */
+extern "C" int BenchmarkLandmarks(int argc, char **argv)
+{
+    Grid               grid;
+    GridSearchInfo     info;
+    LandmarkSearchInfo linfo;
+    DenseGraphSearch   dsearch;
+    Timer::Clock       clk;
+    double             tastar  = 0;
+    double             talt    = 0;
+    long               nrastar = 0;
+    long               nralt   = 0;
+    int                nerrs   = 0;
+    int                goal;
+
+    if(argc < 2)
+    {
+	PrintWarning(printf("usage: BenchmarkLandmarks <map> [dims] [nrLandmarks] [nrQueries]\n"));
+	return 1;
+    }
+
+    const int dims        = argc > 2 ? atoi(argv[2]) : 300;
+    const int nrLandmarks = argc > 3 ? atoi(argv[3]) : 16;
+    const int nrQueries   = argc > 4 ? atoi(argv[4]) : 100;
+
+    if(!ReadGridScene(argv[1], dims, &grid, &info))
+	return 1;
+    dsearch.Setup(grid.GetNrCells());
+
+    RandomStartAndGoal(&info);
+    linfo.m_base = &info;
+    Timer::Start(&clk);
+    linfo.Setup(grid.GetNrCells(), nrLandmarks, info.GetStart());
+    printf("precomputation: %f s (%d landmarks)\n", Timer::Elapsed(&clk), linfo.GetNrLandmarks());
+
+    for(int q = 0; q < nrQueries; ++q)
+    {
+	RandomStartAndGoal(&info);
+	linfo.SetStart(info.GetStart());
+	linfo.SetGoal(info.GetGoal());
+
+	dsearch.m_info = &info;
+	Timer::Start(&clk);
+	const bool   found = dsearch.AStar(info.GetStart(), false, &goal);
+	tastar  += Timer::Elapsed(&clk);
+	nrastar += dsearch.GetNrExpansions();
+	const double cost  = found ? dsearch.GetPathCostFromStart(goal) : HUGE_VAL;
+
+	dsearch.m_info = &linfo;
+	Timer::Start(&clk);
+	const bool   lfound = dsearch.AStar(info.GetStart(), false, &goal);
+	talt  += Timer::Elapsed(&clk);
+	nralt += dsearch.GetNrExpansions();
+	const double lcost  = lfound ? dsearch.GetPathCostFromStart(goal) : HUGE_VAL;
+
+	if(found != lfound || (found && fabs(cost - lcost) > Constants::SQRT_EPSILON))
+	    ++nerrs;
+    }
+
+    printf("map=%s grid=%dx%d queries=%d\n", argv[1], dims, dims, nrQueries);
+    printf("A* (octile): %f s (%ld expansions)\n", tastar, nrastar);
+    printf("A* (ALT)   : %f s (%ld expansions)\n", talt, nralt);
+    if(nerrs > 0)
+    {
+	PrintError(printf("path costs differ in %d queries\n", nerrs));
+	return 1;
+    }
+
+    return 0;
+}
+
+extern "C" int BenchmarkDeltaStepping(int argc, char **argv)
+{
+    const int      dims      = argc > 1 ? atoi(argv[1]) : 1000;
+    const int      nrThreads = argc > 2 ? atoi(argv[2]) : 0;
+    const double   density   = argc > 3 ? atof(argv[3]) : 0.25;
+    const int      nrQueries = argc > 4 ? atoi(argv[4]) : 5;
+    Grid           grid;
+    GridSearchInfo info;
+    CSRGraph       graph;
+    FlowField      field;
+    DeltaStepping  dstep;
+    Timer::Clock   clk;
+    double         tdijkstra = 0;
+    double         tdelta    = 0;
+    int            nerrs     = 0;
+
+    grid.Setup2D(dims, dims, 0, 0, dims, dims);
+
+    bool *occupied = new bool[dims * dims];
+    for(int i = 0; i < dims * dims; ++i)
+	occupied[i] = RandomUniformReal(0, 1) < density;
+    info.Setup(&grid, occupied);
+    delete[] occupied;
+
+    graph.Setup(grid.GetNrCells(), &info);
+    field.m_info = &info;
+    field.Setup(grid.GetNrCells());
+    dstep.m_graph     = &graph;
+    dstep.m_nrThreads = nrThreads;
+
+    for(int q = 0; q < nrQueries; ++q)
+    {
+	RandomStartAndGoal(&info);
+
+	//the grid is undirected, so the costs to the goal are the costs from it
+	Timer::Start(&clk);
+	field.Compute(info.GetGoal());
+	tdijkstra += Timer::Elapsed(&clk);
+
+	Timer::Start(&clk);
+	dstep.Run(info.GetGoal());
+	tdelta += Timer::Elapsed(&clk);
+
+	for(int u = 0; u < grid.GetNrCells(); ++u)
+	{
+	    const double cost = field.GetCostToGoal(u);
+	    const int    p    = dstep.GetParent(u);
+
+	    if(dstep.IsVisited(u) != field.CanReachGoal(u) ||
+	       (dstep.IsVisited(u) && (fabs(cost - dstep.GetPathCostFromStart(u)) > Constants::SQRT_EPSILON ||
+				       fabs(dstep.GetPathCostFromStart(p) + info.OctileDistance(p, u) -
+					    dstep.GetPathCostFromStart(u)) > Constants::SQRT_EPSILON)))
+		++nerrs;
+	}
+    }
+
+    printf("grid=%dx%d edges=%d queries=%d threads=%d\n", dims, dims, graph.GetNrEdges(), nrQueries,
+	   nrThreads > 0 ? nrThreads : GetNrHardwareThreads());
+    printf("Dijkstra       : %f s\n", tdijkstra);
+    printf("delta-stepping : %f s\n", tdelta);
+    if(nerrs > 0)
+    {
+	PrintError(printf("results differ for %d vertices\n", nerrs));
+	return 1;
+    }
+
+    return 0;
+}
+
+//relative and absolute time allowed over the budget of AnytimeAStar
+static const double BENCHMARK_BUDGET_SLACK      = 0.2;
+static const double BENCHMARK_BUDGET_SLACK_TIME = 0.0005;
+
+//runs of a query over the budget before it counts as late
+static const int    BENCHMARK_BUDGET_RUNS       = 3;
+
+/*
+ * ARA* with a per-query time budget, compared to the optimal cost
+ * found by A* without a budget
+ */
+extern "C" int BenchmarkAnytimeAStar(int argc, char **argv)
+{
+    Grid             grid;
+    GridSearchInfo   info;
+    GraphSearch<int> gsearch;
+    Timer::Clock     clk;
+    double           tastar  = 0;
+    double           tara    = 0;
+    double           tmax    = 0;
+    double           ratios  = 0;
+    double           bounds  = 0;
+    int              nrfound = 0;
+    int              nerrs   = 0;
+    int              goal;
+    double           bound;
+
+    if(argc < 2)
+    {
+	PrintWarning(printf("usage: BenchmarkAnytimeAStar <map> [dims] [budget] [epsilon] [decrease] [nrQueries]\n"));
+	return 1;
+    }
+
+    const int    dims      = argc > 2 ? atoi(argv[2]) : 300;
+    const double budget    = argc > 3 ? atof(argv[3]) : 0.005;
+    const double epsilon   = argc > 4 ? atof(argv[4]) : 3;
+    const double decrease  = argc > 5 ? atof(argv[5]) : 0.5;
+    const int    nrQueries = argc > 6 ? atoi(argv[6]) : 50;
+
+    //the budget is checked every 32 expansions and while reweighting,
+    //so allow for that and for the timer
+    const double limit = budget * (1 + BENCHMARK_BUDGET_SLACK) + BENCHMARK_BUDGET_SLACK_TIME;
+
+    if(!ReadGridScene(argv[1], dims, &grid, &info))
+	return 1;
+    gsearch.m_info = &info;
+
+    for(int q = 0; q < nrQueries; ++q)
+    {
+	RandomStartAndGoal(&info);
+
+	//the first query starts at the goal, which must end at once with bound 1
+	if(q == 0)
+	    info.SetGoal(info.GetStart());
+
+	Timer::Start(&clk);
+	const bool   found = gsearch.AStar(info.GetStart(), false, &goal);
+	tastar += Timer::Elapsed(&clk);
+	const double cost  = found ? gsearch.GetPathCostFromStart(goal) : HUGE_VAL;
+
+	Timer::Start(&clk);
+	bool   afound = gsearch.AnytimeAStar(info.GetStart(), epsilon, decrease, budget, &goal, &bound);
+	double t      = Timer::Elapsed(&clk);
+
+	//a late query runs again, so that the process being descheduled,
+	//for milliseconds on a loaded machine, is not taken for the search
+	//overrunning its budget, which would happen every time
+	for(int r = 1; r < BENCHMARK_BUDGET_RUNS && t > limit; ++r)
+	{
+	    Timer::Start(&clk);
+	    afound = gsearch.AnytimeAStar(info.GetStart(), epsilon, decrease, budget, &goal, &bound);
+	    t      = std::min(t, Timer::Elapsed(&clk));
+	}
+
+	const double acost = afound ? gsearch.GetPathCostFromStart(goal) : HUGE_VAL;
+
+	tara += t;
+	if(t > tmax)
+	    tmax = t;
+	if(afound)
+	{
+	    std::vector<int> path;
+
+	    gsearch.GetPathFromStart(goal, &path);
+	    ++nrfound;
+	    ratios += cost > 0 ? acost / cost : 1;
+	    bounds += bound;
+	    if(!found || path.front() != info.GetStart() || goal != info.GetGoal() ||
+	       acost < cost - Constants::SQRT_EPSILON || acost > bound * cost + Constants::SQRT_EPSILON ||
+	       !(bound >= 1) || (q == 0 && (bound != 1 || t >= budget)))
+		++nerrs;
+	}
+	else if(found && t < budget)
+	    ++nerrs;
+    }
+
+    const bool late = tmax > limit;
+
+    printf("map=%s grid=%dx%d queries=%d budget=%f epsilon=%f decrease=%f\n",
+	   argv[1], dims, dims, nrQueries, budget, epsilon, decrease);
+    printf("A*  : %f s\n", tastar);
+    printf("ARA*: %f s (max %f s), %d paths, cost/optimal %f, bound %f\n",
+	   tara, tmax, nrfound, nrfound > 0 ? ratios / nrfound : 0, nrfound > 0 ? bounds / nrfound : 0);
+    if(nerrs > 0 || late)
+    {
+	PrintError(printf("invalid results in %d queries%s\n", nerrs, late ? ", worst time over the budget" : ""));
+	return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Overhead of the search counters and the expansion trace; if a file
+ * is given, the trace of the last query is written to it and read back
+ */
+extern "C" int BenchmarkSearchStats(int argc, char **argv)
+{
+    Grid                  grid;
+    GridSearchInfo        info;
+    GraphSearch<int>      gsearch;
+    GraphSearchStats      stats;
+    GraphSearchStats      total;
+    GraphSearchTrace<int> trace;
+    GraphSearchTrace<int> rtrace;
+    Timer::Clock          clk;
+    double                tplain = 0;
+    double                tstats = 0;
+    int                   nerrs  = 0;
+    int                   goal;
+
+    if(argc < 2)
+    {
+	PrintWarning(printf("usage: BenchmarkSearchStats <map> [dims] [nrQueries] [traceFile]\n"));
+	return 1;
+    }
+
+    const int   dims      = argc > 2 ? atoi(argv[2]) : 300;
+    const int   nrQueries = argc > 3 ? atoi(argv[3]) : 50;
+    const char *fname     = argc > 4 ? argv[4] : NULL;
+
+    if(!ReadGridScene(argv[1], dims, &grid, &info))
+	return 1;
+    gsearch.m_info = &info;
+
+    for(int q = 0; q < nrQueries; ++q)
+    {
+	RandomStartAndGoal(&info);
+
+	gsearch.m_stats = NULL;
+	gsearch.m_trace = NULL;
+	Timer::Start(&clk);
+	const bool found = gsearch.AStar(info.GetStart(), false, &goal);
+	tplain += Timer::Elapsed(&clk);
+	const int  nrexp = gsearch.GetNrExpansions();
+
+	gsearch.m_stats = &stats;
+	gsearch.m_trace = &trace;
+	Timer::Start(&clk);
+	const bool sfound = gsearch.AStar(info.GetStart(), false, &goal);
+	tstats += Timer::Elapsed(&clk);
+
+	total.m_nrExpanded       += stats.m_nrExpanded;
+	total.m_nrGenerated      += stats.m_nrGenerated;
+	total.m_nrDecreaseKeys   += stats.m_nrDecreaseKeys;
+	total.m_nrHeuristicEvals += stats.m_nrHeuristicEvals;
+	total.m_time             += stats.m_time;
+	if(stats.m_heapPeak > total.m_heapPeak)
+	    total.m_heapPeak = stats.m_heapPeak;
+
+	if(found != sfound || stats.m_nrExpanded != nrexp || trace.GetNrExpansions() != nrexp ||
+	   (found && trace.GetKey(nrexp - 1) != goal))
+	    ++nerrs;
+    }
+
+    //the trace of the last query goes through the file only if one is given
+    if(fname)
+    {
+	if(!trace.Write(fname) || !rtrace.Read(fname) || rtrace.GetNrExpansions() != trace.GetNrExpansions())
+	    ++nerrs;
+	for(int i = 0; i < rtrace.GetNrExpansions() && i < trace.GetNrExpansions(); ++i)
+	    if(rtrace.GetKey(i) != trace.GetKey(i) || rtrace.GetGCost(i) != trace.GetGCost(i))
+		++nerrs;
+    }
+
+    printf("map=%s grid=%dx%d queries=%d trace=%s\n", argv[1], dims, dims, nrQueries, fname ? fname : "none");
+    printf("without stats: %f s\n", tplain);
+    printf("with stats   : %f s\n", tstats);
+    total.Print(stdout);
+    if(nerrs > 0)
+    {
+	PrintError(printf("stats or trace inconsistent in %d cases\n", nerrs));
+	return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Contraction hierarchy over the graph of a grid, against A* on the
+ * same queries; if a file is given, the hierarchy is saved to it and
+ * the queries run on the one read back
+ */
+extern "C" int BenchmarkContractionHierarchy(int argc, char **argv)
+{
+    Grid                  grid;
+    GridSearchInfo        info;
+    CSRGraph              graph;
+    ContractionHierarchy  ch;
+    ContractionHierarchy  rch;
+    ContractionHierarchy *qch     = &ch;
+    DenseGraphSearch      dsearch;
+    Timer::Clock          clk;
+    double                tastar  = 0;
+    double                tch     = 0;
+    long                  nrastar = 0;
+    long                  nrch    = 0;
+    int                   nerrs   = 0;
+    int                   goal;
+
+    if(argc < 2)
+    {
+	PrintWarning(printf("usage: BenchmarkContractionHierarchy <map> [dims] [nrQueries] [file]\n"));
+	return 1;
+    }
+
+    const int   dims      = argc > 2 ? atoi(argv[2]) : 200;
+    const int   nrQueries = argc > 3 ? atoi(argv[3]) : 1000;
+    const char *fname     = argc > 4 ? argv[4] : NULL;
+
+    if(!ReadGridScene(argv[1], dims, &grid, &info))
+	return 1;
+    graph.Setup(grid.GetNrCells(), &info);
+    dsearch.m_info = &info;
+    dsearch.Setup(grid.GetNrCells());
+
+    Timer::Start(&clk);
+    ch.Setup(&graph);
+    printf("preprocessing: %f s (%d edges, %d shortcuts)\n", Timer::Elapsed(&clk), graph.GetNrEdges(), ch.GetNrShortcuts());
+
+    //queries run on the hierarchy read back from the file, if one is given
+    if(fname)
+    {
+	if(!ch.Write(fname) || !rch.Read(fname))
+	    return 1;
+	qch = &rch;
+    }
+
+    for(int q = 0; q < nrQueries; ++q)
+    {
+	RandomStartAndGoal(&info);
+
+	Timer::Start(&clk);
+	const bool   found = dsearch.AStar(info.GetStart(), false, &goal);
+	tastar  += Timer::Elapsed(&clk);
+	nrastar += dsearch.GetNrExpansions();
+	const double cost  = found ? dsearch.GetPathCostFromStart(goal) : HUGE_VAL;
+
+	Timer::Start(&clk);
+	const double ccost = qch->Query(info.GetStart(), info.GetGoal());
+	tch  += Timer::Elapsed(&clk);
+	nrch += qch->GetNrSettled();
+
+	//the unpacked path must be made of graph edges and add up to the cost
+	std::vector<int> path;
+	double           plen = 0;
+
+	qch->GetPath(&path);
+	for(int i = 1; i < (int) path.size(); ++i)
+	{
+	    int e = graph.GetFirstEdge(path[i - 1]);
+
+	    while(e < graph.GetEndEdge(path[i - 1]) && graph.GetEdgeTarget(e) != path[i])
+		++e;
+	    plen += e < graph.GetEndEdge(path[i - 1]) ? graph.GetEdgeCost(e) : HUGE_VAL;
+	}
+
+	if(fabs(cost - ccost) > Constants::SQRT_EPSILON ||
+	   (found && (path.front() != info.GetStart() || path.back() != info.GetGoal() ||
+		      fabs(plen - cost) > Constants::SQRT_EPSILON)))
+	    ++nerrs;
+    }
+
+    printf("map=%s grid=%dx%d queries=%d\n", argv[1], dims, dims, nrQueries);
+    printf("A*: %f s (%ld expansions)\n", tastar, nrastar);
+    printf("CH: %f s (%ld settled)\n", tch, nrch);
+    if(nerrs > 0)
+    {
+	PrintError(printf("results differ in %d queries\n", nerrs));
+	return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * A* over the CSR graph of a grid through the virtual GraphSearchInfo
+ * interface and through the CSRSearchInfo overload, which must expand
+ * the same keys
+ */
+extern "C" int BenchmarkCSRSearch(int argc, char **argv)
+{
+    Grid             grid;
+    GridSearchInfo   info;
+    CSRGraph         graph;
+    CSRSearchInfo    cinfo;
+    DenseGraphSearch dsearch;
+    Timer::Clock     clk;
+    double           tvirtual  = 0;
+    double           tcsr      = 0;
+    long             nrvirtual = 0;
+    long             nrcsr     = 0;
+    int              nerrs     = 0;
+    int              goal;
+
+    if(argc < 2)
+    {
+	PrintWarning(printf("usage: BenchmarkCSRSearch <map> [dims] [nrQueries]\n"));
+	return 1;
+    }
+
+    const int dims      = argc > 2 ? atoi(argv[2]) : 200;
+    const int nrQueries = argc > 3 ? atoi(argv[3]) : 1000;
+
+    if(!ReadGridScene(argv[1], dims, &grid, &info))
+	return 1;
+    graph.Setup(grid.GetNrCells(), &info);
+
+    //cell coordinates, since grid edges cost 1 or sqrt(2)
+    std::vector<double> points(2 * grid.GetNrCells());
+    int                 coords[2];
+
+    for(int u = 0; u < grid.GetNrCells(); ++u)
+    {
+	grid.GetCoordsFromCellId(u, coords);
+	points[2 * u]     = coords[0];
+	points[2 * u + 1] = coords[1];
+    }
+    cinfo.Setup(&graph);
+    cinfo.SetPoints(points.data());
+    dsearch.m_info = &cinfo;
+    dsearch.Setup(grid.GetNrCells());
+
+    for(int q = 0; q < nrQueries; ++q)
+    {
+	RandomStartAndGoal(&info);
+	cinfo.SetStart(info.GetStart());
+	cinfo.SetGoal(info.GetGoal());
+
+	Timer::Start(&clk);
+	const bool   found  = dsearch.AStar(info.GetStart(), false, &goal);
+	tvirtual  += Timer::Elapsed(&clk);
+	nrvirtual += dsearch.GetNrExpansions();
+	const double cost   = found ? dsearch.GetPathCostFromStart(goal) : HUGE_VAL;
+	const int    nrexps = dsearch.GetNrExpansions();
+
+	Timer::Start(&clk);
+	const bool   cfound = dsearch.AStar(cinfo, info.GetStart(), false, &goal);
+	tcsr  += Timer::Elapsed(&clk);
+	nrcsr += dsearch.GetNrExpansions();
+	const double ccost  = cfound ? dsearch.GetPathCostFromStart(goal) : HUGE_VAL;
+
+	if(found != cfound || cost != ccost || nrexps != dsearch.GetNrExpansions())
+	    ++nerrs;
+    }
+
+    printf("map=%s grid=%dx%d queries=%d\n", argv[1], dims, dims, nrQueries);
+    printf("virtual: %f s (%ld expansions)\n", tvirtual, nrvirtual);
+    printf("CSR    : %f s (%ld expansions)\n", tcsr, nrcsr);
+    if(nerrs > 0)
+    {
+	PrintError(printf("results differ in %d queries\n", nerrs));
+	return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Agents with a common goal: one A* per agent against a single backward
+ * search whose tree answers the agents, with forward A* for the agents
+ * beyond maxCost
+ */
+extern "C" int BenchmarkGoalTree(int argc, char **argv)
+{
+    Grid             grid;
+    GridSearchInfo   info;
+    GraphSearch<int> gsearch;
+    Timer::Clock     clk;
+    double           tastar = 0;
+    double           ttree  = 0;
+    int              nrTree = 0;
+    int              nerrs  = 0;
+    int              goal;
+
+    if(argc < 2)
+    {
+	PrintWarning(printf("usage: BenchmarkGoalTree <map> [dims] [nrAgents] [maxCost]\n"));
+	return 1;
+    }
+
+    const int    dims     = argc > 2 ? atoi(argv[2]) : 200;
+    const int    nrAgents = argc > 3 ? atoi(argv[3]) : 200;
+    const double maxCost  = argc > 4 ? atof(argv[4]) : HUGE_VAL;
+
+    if(!ReadGridScene(argv[1], dims, &grid, &info))
+	return 1;
+    gsearch.m_info = &info;
+
+    RandomStartAndGoal(&info);
+
+    Timer::Start(&clk);
+    gsearch.SearchBackwardFromGoal(info.GetGoal(), maxCost);
+    ttree += Timer::Elapsed(&clk);
+
+    for(int a = 0; a < nrAgents; ++a)
+    {
+	int start;
+
+	do
+	    start = RandomUniformInteger(0, grid.GetNrCells() - 1);
+	while(info.IsOccupied(start));
+	info.SetStart(start);
+
+	Timer::Start(&clk);
+	const bool   found = gsearch.AStar(start, false, &goal);
+	tastar += Timer::Elapsed(&clk);
+	const double cost  = found ? gsearch.GetPathCostFromStart(goal) : HUGE_VAL;
+
+	std::vector<int> path;
+	double           plen = 0;
+
+	nrTree += gsearch.IsInGoalTree(start);
+	Timer::Start(&clk);
+	const bool tfound = gsearch.GetPathToGoal(start, &path);
+	ttree += Timer::Elapsed(&clk);
+
+	//the path must be connected and as short as the one of A*
+	for(int i = 1; i < (int) path.size(); ++i)
+	    plen += info.OctileDistance(path[i - 1], path[i]);
+
+	if(found != tfound ||
+	   (found && (path.front() != start || path.back() != info.GetGoal() ||
+		      fabs(cost - plen) > Constants::SQRT_EPSILON)))
+	    ++nerrs;
+    }
+
+    printf("map=%s grid=%dx%d agents=%d from tree=%d\n", argv[1], dims, dims, nrAgents, nrTree);
+    printf("A* per agent : %f s\n", tastar);
+    printf("goal tree    : %f s\n", ttree);
+    if(nerrs > 0)
+    {
+	PrintError(printf("results differ for %d agents\n", nerrs));
+	return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Theta* and Lazy Theta* against 8-connected A*: costs must not exceed
+ * those of A* and every segment of the paths must be in line of sight
+ */
+extern "C" int BenchmarkThetaStar(int argc, char **argv)
+{
+    Grid             grid;
+    GridSearchInfo   info;
+    DenseGraphSearch dsearch;
+    ThetaStar        theta;
+    Timer::Clock     clk;
+    double           times[3]    = {0, 0, 0};
+    double           costs[3]    = {0, 0, 0};
+    long             nrexps[3]   = {0, 0, 0};
+    long             nrchecks[2] = {0, 0};
+    long             nrhits[2]   = {0, 0};
+    int              nerrs       = 0;
+    int              goal;
+
+    if(argc < 2)
+    {
+	PrintWarning(printf("usage: BenchmarkThetaStar <map> [dims] [nrQueries]\n"));
+	return 1;
+    }
+
+    const int dims      = argc > 2 ? atoi(argv[2]) : 200;
+    const int nrQueries = argc > 3 ? atoi(argv[3]) : 500;
+
+    if(!ReadGridScene(argv[1], dims, &grid, &info))
+	return 1;
+    dsearch.m_info = &info;
+    dsearch.Setup(grid.GetNrCells());
+    theta.Setup(&info);
+
+    for(int q = 0; q < nrQueries; ++q)
+    {
+	RandomStartAndGoal(&info);
+
+	Timer::Start(&clk);
+	const bool found = dsearch.AStar(info.GetStart(), false, &goal);
+	times[0]  += Timer::Elapsed(&clk);
+	nrexps[0] += dsearch.GetNrExpansions();
+	if(found)
+	    costs[0] += dsearch.GetPathCostFromStart(goal);
+
+	for(int k = 0; k < 2; ++k)
+	{
+	    theta.m_lazy = k == 1;
+	    Timer::Start(&clk);
+	    const bool tfound = theta.Search(info.GetStart(), info.GetGoal());
+	    times[k + 1]  += Timer::Elapsed(&clk);
+	    nrexps[k + 1] += theta.GetNrExpansions();
+	    nrchecks[k]   += theta.GetNrLineOfSightChecks();
+	    nrhits[k]     += theta.GetNrCacheHits();
+
+	    if(tfound != found)
+	    {
+		++nerrs;
+		continue;
+	    }
+	    if(!found)
+		continue;
+
+	    std::vector<int> path;
+	    double           plen = 0;
+
+	    theta.GetPathFromStart(info.GetGoal(), &path);
+	    for(int i = 1; i < (int) path.size(); ++i)
+	    {
+		plen += theta.Distance(path[i - 1], path[i]);
+		if(!theta.LineOfSight(path[i - 1], path[i]))
+		    ++nerrs;
+	    }
+	    costs[k + 1] += plen;
+	    if(path.front() != info.GetStart() || path.back() != info.GetGoal() ||
+	       fabs(plen - theta.GetPathCostFromStart(info.GetGoal())) > Constants::SQRT_EPSILON ||
+	       plen > dsearch.GetPathCostFromStart(goal) + Constants::SQRT_EPSILON)
+		++nerrs;
+	}
+    }
+
+    printf("map=%s grid=%dx%d queries=%d\n", argv[1], dims, dims, nrQueries);
+    printf("A*          : %f s (%ld expansions, total cost %f)\n", times[0], nrexps[0], costs[0]);
+    printf("Theta*      : %f s (%ld expansions, total cost %f, %ld checks, %ld cached)\n",
+	   times[1], nrexps[1], costs[1], nrchecks[0], nrhits[0]);
+    printf("Lazy Theta* : %f s (%ld expansions, total cost %f, %ld checks, %ld cached)\n",
+	   times[2], nrexps[2], costs[2], nrchecks[1], nrhits[1]);
+    if(nerrs > 0)
+    {
+	PrintError(printf("invalid paths in %d cases\n", nerrs));
+	return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Roadmaps over the given maps with one thread and with nrThreads
+ * threads, which must give the same graph, and A* queries over them
+ */
+extern "C" int BenchmarkPRM(int argc, char **argv)
+{
+    if(argc < 5)
+    {
+	PrintWarning(printf("usage: BenchmarkPRM <nrSamples> <nrNeighs> <nrThreads> <map> [map ...]\n"));
+	return 1;
+    }
+
+    const int nrSamples = atoi(argv[1]);
+    const int nrNeighs  = atoi(argv[2]);
+    const int nrThreads = atoi(argv[3]) > 0 ? atoi(argv[3]) : GetNrHardwareThreads();
+    int       nerrs     = 0;
+
+    for(int m = 4; m < argc; ++m)
+    {
+	std::vector<Polygon2D*> polys;
+	double                  bbox[4];
+	PRM                     prms[2];
+	double                  times[2];
+	CSRSearchInfo           cinfo;
+	DenseGraphSearch        dsearch;
+	Timer::Clock            clk;
+	int                     nrFound = 0;
+	int                     goal;
+
+	if(!ReadScene(argv[m], &polys, bbox))
+	    return 1;
+	if(polys.empty())
+	{
+	    //same extent as the other maps
+	    bbox[0] = bbox[1] = -30;
+	    bbox[2] = bbox[3] =  30;
+	}
+
+	for(int k = 0; k < 2; ++k)
+	{
+	    prms[k].m_nrNeighs  = nrNeighs;
+	    prms[k].m_nrThreads = k == 0 ? 1 : nrThreads;
+	    prms[k].m_seed      = 1;
+	    prms[k].Setup(polys.size(), polys.data(), bbox);
+	    Timer::Start(&clk);
+	    prms[k].Build(nrSamples);
+	    times[k] = Timer::Elapsed(&clk);
+	}
+
+	const CSRGraph *g0 = prms[0].GetGraph();
+	const CSRGraph *g1 = prms[1].GetGraph();
+
+	if(g0->GetNrEdges() != g1->GetNrEdges() ||
+	   memcmp(prms[0].GetPoints(), prms[1].GetPoints(), 2 * nrSamples * sizeof(double)) != 0 ||
+	   memcmp(g0->GetEdgeTargets(), g1->GetEdgeTargets(), g0->GetNrEdges() * sizeof(int)) != 0)
+	{
+	    PrintError(printf("roadmap of <%s> depends on the number of threads\n", argv[m]));
+	    ++nerrs;
+	}
+
+	//paths over the roadmap must be collision free
+	cinfo.Setup(g0);
+	cinfo.SetPoints(prms[0].GetPoints());
+	dsearch.Setup(g0->GetNrVertices());
+	for(int q = 0; q < 100; ++q)
+	{
+	    cinfo.SetGoal(RandomUniformInteger(0, g0->GetNrVertices() - 1));
+	    if(!dsearch.AStar(cinfo, RandomUniformInteger(0, g0->GetNrVertices() - 1), false, &goal))
+		continue;
+	    ++nrFound;
+
+	    std::vector<int> path;
+
+	    dsearch.GetPathFromStart(goal, &path);
+	    for(int i = 1; i < (int) path.size(); ++i)
+		if(!prms[0].IsSegmentValid(prms[0].GetVertex(path[i - 1]), prms[0].GetVertex(path[i])))
+		    ++nerrs;
+	}
+
+	printf("map=%s vertices=%d edges=%d checks=%d paths=%d/100\n", argv[m],
+	       g0->GetNrVertices(), g0->GetNrEdges() / 2, prms[0].GetNrEdgeChecks(), nrFound);
+	printf("  1 thread : %f s\n", times[0]);
+	printf("  %d threads: %f s\n", nrThreads, times[1]);
+
+	DeleteItems<Polygon2D*>(&polys);
+    }
+
+    if(nerrs > 0)
+    {
+	PrintError(printf("%d errors\n", nerrs));
+	return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Lazy against eager roadmaps on the given maps: same queries, same
+ * path costs, fewer edge checks
+ */
+extern "C" int BenchmarkLazyPRM(int argc, char **argv)
+{
+    if(argc < 5)
+    {
+	PrintWarning(printf("usage: BenchmarkLazyPRM <nrSamples> <nrNeighs> <nrQueries> <map> [map ...]\n"));
+	return 1;
+    }
+
+    const int nrSamples = atoi(argv[1]);
+    const int nrNeighs  = atoi(argv[2]);
+    const int nrQueries = atoi(argv[3]);
+    int       nerrs     = 0;
+
+    for(int m = 4; m < argc; ++m)
+    {
+	std::vector<Polygon2D*> polys;
+	double                  bbox[4];
+	PRM                     prms[2];
+	double                  times[2] = {0, 0};
+	double                  costs[2];
+	bool                    found[2];
+	std::vector<int>        path;
+	Timer::Clock            clk;
+
+	if(!ReadScene(argv[m], &polys, bbox))
+	    return 1;
+	if(polys.empty())
+	{
+	    bbox[0] = bbox[1] = -30;
+	    bbox[2] = bbox[3] =  30;
+	}
+
+	for(int k = 0; k < 2; ++k)
+	{
+	    prms[k].m_nrNeighs = nrNeighs;
+	    prms[k].m_seed     = 1;
+	    prms[k].m_lazy     = k == 1;
+	    prms[k].Setup(polys.size(), polys.data(), bbox);
+	    Timer::Start(&clk);
+	    prms[k].Build(nrSamples);
+	    times[k] += Timer::Elapsed(&clk);
+	}
+
+	for(int q = 0; q < nrQueries; ++q)
+	{
+	    const int start = RandomUniformInteger(0, nrSamples - 1);
+	    const int goal  = RandomUniformInteger(0, nrSamples - 1);
+
+	    for(int k = 0; k < 2; ++k)
+	    {
+		path.clear();
+		Timer::Start(&clk);
+		found[k] = prms[k].SearchPath(start, goal, &path);
+		times[k] += Timer::Elapsed(&clk);
+
+		costs[k] = 0;
+		for(int i = 1; i < (int) path.size(); ++i)
+		{
+		    const double *p0 = prms[k].GetVertex(path[i - 1]);
+		    const double *p1 = prms[k].GetVertex(path[i]);
+
+		    costs[k] += sqrt((p0[0] - p1[0]) * (p0[0] - p1[0]) + (p0[1] - p1[1]) * (p0[1] - p1[1]));
+		    if(!prms[k].IsSegmentValid(p0, p1))
+			++nerrs;
+		}
+	    }
+	    if(found[0] != found[1] || fabs(costs[0] - costs[1]) > Constants::SQRT_EPSILON)
+		++nerrs;
+	}
+
+	printf("map=%s vertices=%d candidate edges=%d queries=%d\n", argv[m],
+	       nrSamples, prms[1].GetGraph()->GetNrEdges() / 2, nrQueries);
+	printf("  eager: %f s (%d edge checks)\n", times[0], prms[0].GetNrEdgeChecks());
+	printf("  lazy : %f s (%d edge checks)\n", times[1], prms[1].GetNrEdgeChecks());
+
+	DeleteItems<Polygon2D*>(&polys);
+    }
+
+    if(nerrs > 0)
+    {
+	PrintError(printf("results differ in %d cases\n", nerrs));
+	return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * k-d tree against the cell list and a linear scan on uniform points
+ * and on points clustered around a few centers, as samples near
+ * obstacles are, then with the points added one at a time
+ */
+extern "C" int BenchmarkKDTree(int argc, char **argv)
+{
+    const int    n         = argc > 1 ? atoi(argv[1]) : 100000;
+    const int    k         = argc > 2 ? atoi(argv[2]) : 10;
+    const int    nrThreads = argc > 3 ? atoi(argv[3]) : 0;
+    const double size      = 100;
+    int          nerrs     = 0;
+
+    for(int clustered = 0; clustered < 2; ++clustered)
+    {
+	std::vector<double> pts(2 * n);
+	std::vector<int>    ids(n);
+	std::vector<int>    neighs;
+	std::vector<double> dists;
+	std::vector<int>    cneighs;
+	std::vector<double> cdists;
+	Grid                grid;
+	CellList            clist;
+	KDTree2D            tree;
+	KDTree2D            itree;
+	Timer::Clock        clk;
+	double              tcell, ttree, tinsert;
+
+	for(int i = 0; i < n; ++i)
+	{
+	    ids[i] = i;
+	    if(clustered)
+	    {
+		//a tenth of the points around each of ten centers
+		const int c = i % 10;
+
+		pts[2 * i]     = 10 + 8 * c + RandomGaussianReal(0, 0.5);
+		pts[2 * i + 1] = 10 + 8 * ((7 * c) % 10) + RandomGaussianReal(0, 0.5);
+	    }
+	    else
+	    {
+		pts[2 * i]     = RandomUniformReal(0, size);
+		pts[2 * i + 1] = RandomUniformReal(0, size);
+	    }
+	}
+
+	//about two points per cell, as if the points were uniform
+	const int dims = (int) sqrt(n / 2.0) < 1 ? 1 : (int) sqrt(n / 2.0);
+
+	grid.Setup2D(dims, dims, 0, 0, size, size);
+	clist.Setup(&grid);
+
+	Timer::Start(&clk);
+	clist.Rebuild(n, &pts[0]);
+	for(int i = 0; i < n; ++i)
+	    clist.GetKNearest(&pts[2 * i], k, &cneighs, &cdists, i);
+	tcell = Timer::Elapsed(&clk);
+
+	Timer::Start(&clk);
+	tree.Build(n, &pts[0]);
+	tree.GetKNearest(n, &pts[0], k, &neighs, &dists, &ids[0], nrThreads);
+	ttree = Timer::Elapsed(&clk);
+
+	Timer::Start(&clk);
+	for(int i = 0; i < n; ++i)
+	    itree.AddPoint(&pts[2 * i]);
+	tinsert = Timer::Elapsed(&clk);
+
+	for(int i = 0; i < n; ++i)
+	    if(fabs(dists[k * i + k - 1] - cdists[k * i + k - 1]) > Constants::EPSILON)
+		++nerrs;
+
+	//spot check the k-nearest and radius queries against a linear scan
+	for(int i = 0; i < n; i += 997)
+	{
+	    std::vector<int>    ineighs, rneighs;
+	    std::vector<double> idists;
+	    const double        r   = (1 + Constants::SQRT_EPSILON) * dists[k * i + k - 1];
+	    int                 nin = 0;
+
+	    itree.GetKNearest(&pts[2 * i], k, &ineighs, &idists, i);
+	    tree.GetNeighsInRadius(&pts[2 * i], r, &rneighs, i);
+	    for(int j = 0; j < n; ++j)
+		if(j != i &&
+		   (pts[2 * i] - pts[2 * j]) * (pts[2 * i] - pts[2 * j]) +
+		   (pts[2 * i + 1] - pts[2 * j + 1]) * (pts[2 * i + 1] - pts[2 * j + 1]) <= r * r)
+		    ++nin;
+	    if(nin < k || nin != (int) rneighs.size() || fabs(idists.back() - dists[k * i + k - 1]) > Constants::EPSILON)
+		++nerrs;
+	}
+
+	printf("%s points=%d k=%d\n", clustered ? "clustered" : "uniform", n, k);
+	printf("  cell list        : %f s\n", tcell);
+	printf("  k-d tree (batch) : %f s\n", ttree);
+	printf("  k-d tree inserts : %f s\n", tinsert);
+    }
+
+    if(nerrs > 0)
+    {
+	PrintError(printf("results differ in %d cases\n", nerrs));
+	return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Label the connected components of an undirected graph
+ */
+static void LabelComponents(const CSRGraph * const graph, std::vector<int> * const labels)
+{
+    std::vector<int> stack;
+
+    labels->assign(graph->GetNrVertices(), -1);
+    for(int s = 0; s < graph->GetNrVertices(); ++s)
+	if((*labels)[s] < 0)
+	{
+	    (*labels)[s] = s;
+	    stack.push_back(s);
+	    while(!stack.empty())
+	    {
+		const int u   = stack.back();
+		const int end = graph->GetEndEdge(u);
+
+		stack.pop_back();
+		for(int e = graph->GetFirstEdge(u); e < end; ++e)
+		    if((*labels)[graph->GetEdgeTarget(e)] < 0)
+		    {
+			(*labels)[graph->GetEdgeTarget(e)] = s;
+			stack.push_back(graph->GetEdgeTarget(e));
+		    }
+	    }
+	}
+}
+
+/*
+ * Connected start and goal pairs on the given maps for roadmaps of
+ * increasing size, with uniform, Gaussian, bridge-test and boundary
+ * sampling, the last two mixed half and half with uniform samples, and
+ * with Halton, scrambled Sobol and R2 points.
+ * Start and goal join the roadmap through the nearest vertex they see.
+ * The map <passage> is a wall across [-30, 30]^2 with a gap of width 1.
+ */
+extern "C" int BenchmarkPRMSamplers(int argc, char **argv)
+{
+    if(argc < 3)
+    {
+	PrintWarning(printf("usage: BenchmarkPRMSamplers <nrQueries> <map> [map ...]\n"));
+	return 1;
+    }
+
+    const int   nrQueries = atoi(argv[1]);
+    const char *names[]   = {"uniform", "gaussian", "bridge", "boundary", "halton", "sobol", "r2"};
+    int         nerrs     = 0;
+
+    for(int m = 2; m < argc; ++m)
+    {
+	std::vector<Polygon2D*> polys;
+	double                  bbox[4];
+	std::vector<double>     queries(4 * nrQueries);
+	std::vector<int>        labels;
+	std::vector<int>        neighs;
+	int                     attached[2];
+	KDTree2D                tree;
+	PRMUniformSampler       uniform;
+	PRMGaussianSampler      gaussian;
+	PRMBridgeSampler        bridge;
+	PRMBoundarySampler      boundary;
+	PRMMixedSampler         mixedBridge;
+	PRMMixedSampler         mixedBoundary;
+	PRMQuasiRandomSampler   quasi[3];
+	PRMSampler             *samplers[] = {&uniform, &gaussian, &mixedBridge, &mixedBoundary,
+					      &quasi[0], &quasi[1], &quasi[2]};
+	RandomStream            rng(7);
+	PRM                     prm;
+
+	if(strcmp(argv[m], "passage") == 0)
+	{
+	    polys.push_back(new Polygon2D());
+	    polys.back()->Rectangle(-1, -30, 1, -0.5);
+	    polys.push_back(new Polygon2D());
+	    polys.back()->Rectangle(-1, 0.5, 1, 30);
+	    bbox[0] = bbox[1] = -30;
+	    bbox[2] = bbox[3] =  30;
+	}
+	else if(!ReadScene(argv[m], &polys, bbox))
+	    return 1;
+	if(polys.empty())
+	{
+	    bbox[0] = bbox[1] = -30;
+	    bbox[2] = bbox[3] =  30;
+	}
+	prm.m_seed      = 1;
+	prm.m_nrThreads = 1;
+	prm.Setup(polys.size(), polys.data(), bbox);
+
+	//passages are a few percent of the scene wide
+	gaussian.m_stddev = bridge.m_stddev = 0.02 * (bbox[2] - bbox[0]);
+	boundary.m_stddev = 0.01 * (bbox[2] - bbox[0]);
+	mixedBridge.AddSampler(&uniform, 0.5);
+	mixedBridge.AddSampler(&bridge, 0.5);
+	mixedBoundary.AddSampler(&uniform, 0.5);
+	mixedBoundary.AddSampler(&boundary, 0.5);
+	quasi[0].m_sequence.Setup(QuasiRandom::HALTON);
+	quasi[1].m_sequence.Setup(QuasiRandom::SOBOL, 1);
+	quasi[2].m_sequence.Setup(QuasiRandom::R2);
+
+	for(int i = 0; i < 2 * nrQueries; ++i)
+	    while(!uniform.Sample(prm, &rng, &queries[2 * i]))
+		;
+
+	printf("map=%s connected pairs out of %d\n  samples ", argv[m], nrQueries);
+	for(int n = 25; n <= 3200; n *= 2)
+	    printf("%6d", n);
+	printf("\n");
+
+	for(int s = 0; s < 7; ++s)
+	{
+	    prm.m_sampler = samplers[s];
+	    printf("  %-8s", names[s]);
+	    for(int n = 25; n <= 3200; n *= 2)
+	    {
+		int nrConnected = 0;
+
+		prm.Build(n);
+		LabelComponents(prm.GetGraph(), &labels);
+		tree.Build(prm.GetNrVertices(), prm.GetPoints());
+		for(int q = 0; q < nrQueries; ++q)
+		{
+		    for(int k = 0; k < 2; ++k)
+		    {
+			const double *p = &queries[4 * q + 2 * k];
+
+			neighs.clear();
+			tree.GetKNearest(p, 10, &neighs);
+			attached[k] = -1;
+			for(int i = 0; i < (int) neighs.size() && attached[k] < 0; ++i)
+			    if(prm.IsSegmentValid(p, prm.GetVertex(neighs[i])))
+				attached[k] = labels[neighs[i]];
+		    }
+		    if(attached[0] >= 0 && attached[0] == attached[1])
+			++nrConnected;
+		}
+		printf("%6d", nrConnected);
+	    }
+	    printf("\n");
+
+	    //the samplers must not depend on the number of threads either
+	    std::vector<double> pts(prm.GetPoints(), prm.GetPoints() + 2 * prm.GetNrVertices());
+
+	    prm.m_nrThreads = 4;
+	    prm.Build(3200);
+	    if(memcmp(&pts[0], prm.GetPoints(), pts.size() * sizeof(double)) != 0)
+		++nerrs;
+	    prm.m_nrThreads = 1;
+	}
+
+	DeleteItems<Polygon2D*>(&polys);
+    }
+
+    if(nerrs > 0)
+    {
+	PrintError(printf("roadmaps depend on the number of threads in %d cases\n", nerrs));
+	return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * L2-star discrepancy of n points in the unit square, with the formula
+ * of Warnock
+ */
+static double L2StarDiscrepancy(const int n, const double u[])
+{
+    double s1 = 0;
+    double s2 = 0;
+
+    for(int i = 0; i < n; ++i)
+    {
+	s1 += (1 - u[2 * i] * u[2 * i]) * (1 - u[2 * i + 1] * u[2 * i + 1]) / 4;
+	for(int j = 0; j < n; ++j)
+	    s2 += (1 - (u[2 * i] > u[2 * j] ? u[2 * i] : u[2 * j])) *
+		(1 - (u[2 * i + 1] > u[2 * j + 1] ? u[2 * i + 1] : u[2 * j + 1]));
+    }
+
+    return sqrt(1.0 / 9 - 2 * s1 / n + s2 / ((double) n * n));
+}
+
+/*
+ * Discrepancy of pseudo-random, Halton, scrambled Sobol and R2 points,
+ * and quasi-random points mapped to the polygons of a map, which must
+ * fall inside them
+ */
+extern "C" int BenchmarkQuasiRandom(int argc, char **argv)
+{
+    const int   n       = argc > 1 ? atoi(argv[1]) : 4096;
+    const char *names[] = {"pseudo-random", "halton", "sobol", "sobol scrambled", "r2"};
+    QuasiRandom seqs[4];
+    int         nerrs   = 0;
+
+    seqs[0].Setup(QuasiRandom::HALTON);
+    seqs[1].Setup(QuasiRandom::SOBOL);
+    seqs[2].Setup(QuasiRandom::SOBOL, 1);
+    seqs[3].Setup(QuasiRandom::R2);
+
+    printf("L2-star discrepancy\n  points           ");
+    for(int m = 64; m <= n; m *= 4)
+	printf("%10d", m);
+    printf("\n");
+    for(int s = 0; s < 5; ++s)
+    {
+	printf("  %-17s", names[s]);
+	for(int m = 64; m <= n; m *= 4)
+	{
+	    std::vector<double> u(2 * m);
+	    RandomStream        rng(1);
+
+	    for(int i = 0; i < m; ++i)
+		if(s == 0)
+		{
+		    u[2 * i]     = rng.UniformReal();
+		    u[2 * i + 1] = rng.UniformReal();
+		}
+		else
+		    seqs[s - 1].GetPoint(i, &u[2 * i]);
+	    printf("%10.6f", L2StarDiscrepancy(m, &u[0]));
+	}
+	printf("\n");
+    }
+
+    //same points from the index and in order
+    for(int s = 0; s < 4; ++s)
+    {
+	double u[2], v[2];
+
+	seqs[s].Setup(seqs[s].GetSequence(), s == 2 ? 1 : 0);
+	for(int i = 0; i < 1000; ++i)
+	{
+	    seqs[s].Next(u);
+	    seqs[s].GetPoint(i, v);
+	    if(u[0] != v[0] || u[1] != v[1] || u[0] < 0 || u[0] >= 1 || u[1] < 0 || u[1] >= 1)
+		++nerrs;
+	}
+    }
+
+    if(argc > 2)
+    {
+	std::vector<Polygon2D*> polys;
+	double                  bbox[4];
+	int                     nout = 0;
+
+	if(!ReadScene(argv[2], &polys, bbox))
+	    return 1;
+	for(int i = 0; i < (int) polys.size(); ++i)
+	{
+	    const std::vector<double> & poly = polys[i]->m_vertices;
+	    double                      u[2], p[2], pmin[2];
+
+	    for(int j = 0; j < 1000; ++j)
+	    {
+		seqs[2].GetPoint(j, u);
+		MapUnitSquareToPolygon2D(u, polys[i], p);
+		if(!IsPointInsidePolygon2D(p, poly.size() / 2, &poly[0]) &&
+		   DistSquaredPointPolygon2D(p, poly.size() / 2, &poly[0], pmin) > Constants::EPSILON)
+		    ++nout;
+	    }
+	}
+	printf("map=%s polygons=%d points outside=%d\n", argv[2], (int) polys.size(), nout);
+	nerrs += nout;
+
+	DeleteItems<Polygon2D*>(&polys);
+    }
+
+    if(nerrs > 0)
+    {
+	PrintError(printf("%d errors\n", nerrs));
+	return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * A* over the free leaves of a quadtree against A* over the grid of its
+ * smallest leaves on the given map: every quadtree path must be free of
+ * collisions and found only when the grid has a path too
+ */
+extern "C" int BenchmarkQuadtree(int argc, char **argv)
+{
+    if(argc < 2)
+    {
+	PrintWarning(printf("usage: BenchmarkQuadtree <map> [dims] [nrQueries]\n"));
+	return 1;
+    }
+
+    const int               dims      = argc > 2 ? atoi(argv[2]) : 256;
+    const int               nrQueries = argc > 3 ? atoi(argv[3]) : 100;
+    std::vector<Polygon2D*> polys;
+    double                  bbox[4];
+    Grid                    grid;
+    SceneOccupancy          occ;
+    GridSearchInfo          info;
+    DenseGraphSearch        dsearch;
+    Quadtree2D              qtree;
+    Quadtree2DSearchInfo    qinfo;
+    GraphSearch<int>        qsearch;
+    Timer::Clock            clk;
+    double                  tgrid   = 0;
+    double                  tqtree  = 0;
+    double                  ratio   = 0;
+    int                     nrBoth  = 0;
+    int                     nrGrid  = 0;
+    int                     nerrs   = 0;
+    int                     goal;
+
+    if(!ReadScene(argv[1], &polys, bbox))
+	return 1;
+
+    //square cells, so that the grid costs are lengths
+    const double side = std::max(bbox[2] - bbox[0], bbox[3] - bbox[1]);
+
+    bbox[2] = bbox[0] + side;
+    bbox[3] = bbox[1] + side;
+    grid.Setup2D(dims, dims, bbox[0], bbox[1], bbox[2], bbox[3]);
+    occ.Compute(&grid, polys.size(), polys.data());
+
+    bool *occupied = new bool[grid.GetNrCells()];
+    occ.GetOccupied(occupied);
+    info.Setup(&grid, occupied);
+    delete[] occupied;
+    dsearch.m_info = &info;
+    dsearch.Setup(grid.GetNrCells());
+
+    //leaves stop at the size of the grid cells
+    const double cell = side / dims;
+
+    qtree.Setup(&bbox[0], &bbox[2], 0.99 * cell);
+    qtree.Build(polys.size(), polys.data());
+    qinfo.m_quadtree = &qtree;
+    qsearch.m_info   = &qinfo;
+
+    for(int q = 0; q < nrQueries; ++q)
+    {
+	double ps[2], pg[2];
+
+	RandomStartAndGoal(&info);
+	grid.GetCellCenterFromId(info.GetStart(), ps);
+	grid.GetCellCenterFromId(info.GetGoal(), pg);
+
+	Timer::Start(&clk);
+	const bool   found = dsearch.AStar(info.GetStart(), false, &goal);
+	tgrid += Timer::Elapsed(&clk);
+	const double cost  = found ? dsearch.GetPathCostFromStart(goal) * cell : HUGE_VAL;
+
+	const int start = qtree.LocateLeaf(ps);
+
+	if(start < 0 || !qinfo.IsTraversable(start) || !qinfo.SetGoal(pg))
+	    continue;
+
+	Timer::Start(&clk);
+	const bool qfound = qsearch.AStar(start, false, &goal);
+	tqtree += Timer::Elapsed(&clk);
+
+	nrGrid += found;
+	if(!qfound)
+	    continue;
+	if(!found)
+	{
+	    ++nerrs;
+	    continue;
+	}
+	++nrBoth;
+
+	//the start point, the leaf centers, which are in line of sight
+	//across the shared sides, and the goal point
+	std::vector<int>    path;
+	std::vector<double> pts(ps, ps + 2);
+	double              qcost = 0;
+
+	qsearch.GetPathFromStart(goal, &path);
+	for(int i = 0; i < (int) path.size(); ++i)
+	{
+	    pts.resize(pts.size() + 2);
+	    qtree.GetNodeCenter(path[i], &pts[pts.size() - 2]);
+	}
+	pts.insert(pts.end(), pg, pg + 2);
+
+	for(int i = 2; i < (int) pts.size(); i += 2)
+	{
+	    qcost += sqrt((pts[i] - pts[i - 2]) * (pts[i] - pts[i - 2]) +
+			  (pts[i + 1] - pts[i - 1]) * (pts[i + 1] - pts[i - 1]));
+	    for(int j = 0; j < (int) polys.size(); ++j)
+		if(CollisionSegmentPolygon2D(&pts[i - 2], &pts[i],
+					     polys[j]->m_vertices.size() / 2, &(polys[j]->m_vertices[0])))
+		{
+		    ++nerrs;
+		    break;
+		}
+	}
+	ratio += qcost / cost;
+    }
+
+    printf("map=%s grid=%dx%d leaves=%d (free=%d) queries=%d\n", argv[1], dims, dims,
+	   qtree.GetNrLeaves(), qtree.GetNrLeaves(Quadtree2D::STATUS_FREE), nrQueries);
+    printf("grid A*    : %f s\n", tgrid);
+    printf("quadtree A*: %f s (%d/%d paths, cost ratio %f)\n", tqtree, nrBoth, nrGrid,
+	   nrBoth > 0 ? ratio / nrBoth : 0.0);
+
+    DeleteItems<Polygon2D*>(&polys);
+
+    if(nerrs > 0)
+    {
+	PrintError(printf("%d quadtree paths collide or have no grid path\n", nerrs));
+	return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * SparseGrid::AddPolygon against SceneOccupancy over a grid with the
+ * same cells: each cell must store the same obstacles. SparseGrid
+ * cells past the max side of the bounding box, which the grid folds
+ * into its last row or column, are only counted.
+ */
+extern "C" int BenchmarkSparseGrid(int argc, char **argv)
+{
+    if(argc < 2)
+    {
+	PrintWarning(printf("usage: BenchmarkSparseGrid <map> [dims]\n"));
+	return 1;
+    }
+
+    const int               dims   = argc > 2 ? atoi(argv[2]) : 256;
+    std::vector<Polygon2D*> polys;
+    double                  bbox[4];
+    Grid                    grid;
+    SceneOccupancy          occ;
+    SparseGrid              sgrid;
+    Timer::Clock            clk;
+    int                     coords[2];
+    int                     nerrs  = 0;
+    int                     nrPast = 0;
+
+    if(!ReadScene(argv[1], &polys, bbox))
+	return 1;
+
+    grid.Setup2D(dims, dims, bbox[0], bbox[1], bbox[2], bbox[3]);
+    sgrid.Setup2D(grid.GetUnits()[0], grid.GetUnits()[1], bbox[0], bbox[1]);
+
+    Timer::Start(&clk);
+    occ.Compute(&grid, polys.size(), polys.data(), 1);
+    const double tgrid = Timer::Elapsed(&clk);
+
+    Timer::Start(&clk);
+    for(int i = 0; i < (int) polys.size(); ++i)
+	if(!sgrid.AddPolygon(i, polys[i]))
+	    ++nerrs;
+    const double tsparse = Timer::Elapsed(&clk);
+
+    //every grid cell against the sparse cell with the same coordinates
+    for(int id = 0; id < grid.GetNrCells(); ++id)
+    {
+	int n;
+
+	grid.GetCoordsFromCellId(id, coords);
+
+	const int              *obst  = occ.GetCellObstacles(id, &n);
+	const std::vector<int> *items = sgrid.GetCellItems(sgrid.GetCellKeyFromCoords(coords));
+	std::vector<int>        sorted;
+
+	if(items)
+	{
+	    sorted = *items;
+	    std::sort(sorted.begin(), sorted.end());
+	}
+	if((int) sorted.size() != n || !std::equal(sorted.begin(), sorted.end(), obst))
+	    ++nerrs;
+    }
+
+    //sparse cells that the grid does not have
+    std::vector<SparseGrid::CellKey> keys;
+
+    sgrid.GetCellKeys(&keys);
+    for(int i = 0; i < (int) keys.size(); ++i)
+    {
+	sgrid.GetCoordsFromCellKey(keys[i], coords);
+	if(coords[0] < 0 || coords[1] < 0)
+	    ++nerrs;
+	else if(coords[0] >= dims || coords[1] >= dims)
+	    ++nrPast;
+    }
+
+    printf("map=%s obstacles=%d grid=%dx%d\n", argv[1], (int) polys.size(), dims, dims);
+    printf("SceneOccupancy: %f s (%d occupied cells)\n", tgrid, occ.GetNrOccupiedCells());
+    printf("SparseGrid    : %f s (%d cells, %d past the max sides)\n", tsparse, sgrid.GetNrCells(), nrPast);
+
+    DeleteItems<Polygon2D*>(&polys);
+
+    if(nerrs > 0)
+    {
+	PrintError(printf("%d cells differ\n", nerrs));
+	return 1;
+    }
+
+    return 0;
+}
+
+/*
+ * Scan of the level 0 cells that the box or the segment overlaps, the
+ * same cells that OccupancyPyramid2D resolves
+ */
+static int BenchmarkPyramidClassifyBox(const Grid & grid, const bool occupied[],
+				       const double min[2], const double max[2])
+{
+    const double *gmin         = grid.GetMin();
+    const double *gmax         = grid.GetMax();
+    bool          seenFree     = false;
+    bool          seenOccupied = false;
+    int           range[4];
+
+    if(max[0] < gmin[0] || min[0] > gmax[0] || max[1] < gmin[1] || min[1] > gmax[1])
+	return OccupancyPyramid2D::STATUS_FREE;
+
+    grid.GetCoords(min, &range[0]);
+    grid.GetCoords(max, &range[2]);
+    for(int y = range[1]; y <= range[3]; ++y)
+	for(int x = range[0]; x <= range[2]; ++x)
+	{
+	    const int coords[2] = {x, y};
+
+	    if(occupied[grid.GetCellIdFromCoords(coords)])
+		seenOccupied = true;
+	    else
+		seenFree = true;
+	}
+
+    return seenOccupied ? (seenFree ? OccupancyPyramid2D::STATUS_MIXED : OccupancyPyramid2D::STATUS_OCCUPIED) :
+	OccupancyPyramid2D::STATUS_FREE;
+}
+
+static bool BenchmarkPyramidIsSegmentFree(const Grid & grid, const bool occupied[],
+					  const double p1[2], const double p2[2])
+{
+    const double min[2] = {std::min(p1[0], p2[0]), std::min(p1[1], p2[1])};
+    const double max[2] = {std::max(p1[0], p2[0]), std::max(p1[1], p2[1])};
+    const double *gmin  = grid.GetMin();
+    const double *gmax  = grid.GetMax();
+    const double *units = grid.GetUnits();
+    int           range[4];
+
+    if(max[0] < gmin[0] || min[0] > gmax[0] || max[1] < gmin[1] || min[1] > gmax[1])
+	return true;
+
+    grid.GetCoords(min, &range[0]);
+    grid.GetCoords(max, &range[2]);
+    for(int y = range[1]; y <= range[3]; ++y)
+	for(int x = range[0]; x <= range[2]; ++x)
+	{
+	    const int coords[2] = {x, y};
+
+	    if(!occupied[grid.GetCellIdFromCoords(coords)])
+		continue;
+
+	    //clip the segment against the closed cell
+	    const double cmin[2] = {gmin[0] + units[0] * x, gmin[1] + units[1] * y};
+	    const double cmax[2] = {gmin[0] + units[0] * (x + 1), gmin[1] + units[1] * (y + 1)};
+	    double       tmin    = 0;
+	    double       tmax    = 1;
+
+	    for(int i = 0; i < 2 && tmin <= tmax; ++i)
+	    {
+		const double d = p2[i] - p1[i];
+
+		if(d == 0)
+		{
+		    if(p1[i] < cmin[i] || p1[i] > cmax[i])
+			tmin = 2;
+		    continue;
+		}
+
+		const double t1 = (cmin[i] - p1[i]) / d;
+		const double t2 = (cmax[i] - p1[i]) / d;
+
+		tmin = std::max(tmin, std::min(t1, t2));
+		tmax = std::min(tmax, std::max(t1, t2));
+	    }
+	    if(tmin <= tmax)
+		return false;
+	}
+
+    return true;
+}
+
+/*
+ * OccupancyPyramid2D box and segment queries against a scan of the
+ * level 0 cells, on random boxes and segments of all sizes, some of
+ * them partly outside the grid
+ */
+extern "C" int BenchmarkOccupancyPyramid(int argc, char **argv)
+{
+    if(argc < 2)
+    {
+	PrintWarning(printf("usage: BenchmarkOccupancyPyramid <map> [dims] [nrQueries]\n"));
+	return 1;
+    }
+
+    const int               dims      = argc > 2 ? atoi(argv[2]) : 256;
+    const int               nrQueries = argc > 3 ? atoi(argv[3]) : 10000;
+    std::vector<Polygon2D*> polys;
+    double                  bbox[4];
+    Grid                    grid;
+    SceneOccupancy          occ;
+    OccupancyPyramid2D      pyramid;
+    Timer::Clock            clk;
+    double                  tpyr      = 0;
+    double                  tscan     = 0;
+    int                     nerrs     = 0;
+    int                     nrFree    = 0;
+    int                     counts[3] = {0, 0, 0};
+
+    if(!ReadScene(argv[1], &polys, bbox))
+	return 1;
+
+    grid.Setup2D(dims, dims, bbox[0], bbox[1], bbox[2], bbox[3]);
+    occ.Compute(&grid, polys.size(), polys.data());
+
+    bool *occupied = new bool[grid.GetNrCells()];
+
+    occ.GetOccupied(occupied);
+    pyramid.Build(&grid, occupied);
+
+    const double ext[2] = {bbox[2] - bbox[0], bbox[3] - bbox[1]};
+
+    for(int q = 0; q < nrQueries; ++q)
+    {
+	//endpoints up to a tenth of the extent outside the grid, with
+	//sizes spread over the levels of the pyramid
+	const double scale = pow(2.0, -RandomUniformReal(0, log2(dims)));
+	double       p1[2], p2[2], min[2], max[2];
+
+	for(int i = 0; i < 2; ++i)
+	{
+	    p1[i]  = RandomUniformReal(bbox[i] - 0.1 * ext[i], bbox[i + 2] + 0.1 * ext[i]);
+	    p2[i]  = p1[i] + scale * RandomUniformReal(-ext[i], ext[i]);
+	    min[i] = std::min(p1[i], p2[i]);
+	    max[i] = std::max(p1[i], p2[i]);
+	}
+
+	Timer::Start(&clk);
+	const int  status  = pyramid.ClassifyBox(min, max);
+	const bool boxFree = pyramid.IsBoxFree(min, max);
+	const bool segFree = pyramid.IsSegmentFree(p1, p2);
+	tpyr += Timer::Elapsed(&clk);
+
+	Timer::Start(&clk);
+	const int  sstatus = BenchmarkPyramidClassifyBox(grid, occupied, min, max);
+	const bool sseg    = BenchmarkPyramidIsSegmentFree(grid, occupied, p1, p2);
+	tscan += Timer::Elapsed(&clk);
+
+	if(status != sstatus || boxFree != (sstatus == OccupancyPyramid2D::STATUS_FREE) || segFree != sseg)
+	    ++nerrs;
+	++counts[sstatus];
+	nrFree += sseg;
+    }
+
+    printf("map=%s grid=%dx%d levels=%d queries=%d\n", argv[1], dims, dims, pyramid.GetNrLevels(), nrQueries);
+    printf("boxes free/occupied/mixed: %d/%d/%d, free segments: %d\n",
+	   counts[OccupancyPyramid2D::STATUS_FREE], counts[OccupancyPyramid2D::STATUS_OCCUPIED],
+	   counts[OccupancyPyramid2D::STATUS_MIXED], nrFree);
+    printf("pyramid: %f s\n", tpyr);
+    printf("scan   : %f s\n", tscan);
+
+    delete[] occupied;
+    DeleteItems<Polygon2D*>(&polys);
+
+    if(nerrs > 0)
+    {
+	PrintError(printf("%d queries differ\n", nerrs));
+	return 1;
+    }
+
+    return 0;
+}
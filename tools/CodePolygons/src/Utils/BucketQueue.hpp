@@ -0,0 +1,161 @@
+#ifndef ABETARE__BUCKET_QUEUE_HPP_
+#define ABETARE__BUCKET_QUEUE_HPP_
+
+#include <vector>
+
+namespace Abetare
+{
+    /**
+     *@brief Monotone priority queue for integer costs over dense
+     *       integer keys (Dial's buckets)
+     *
+     *@par Description:
+     *  There is one bucket per cost, used circularly, so operations
+     *  take constant time apart from skipping empty buckets when the
+     *  top is removed. The queue is monotone: a key can only be
+     *  inserted or updated with a cost that is at least the cost of
+     *  the last removed top and less than that cost plus the number of
+     *  buckets. With nonnegative integer edge costs no larger than
+     *  <em>maxEdgeCost</em>, Dijkstra and A* with a consistent integer
+     *  heuristic satisfy this when there are
+     *  <em>maxEdgeCost + 1</em> buckets.
+     */
+    class BucketQueue
+    {
+    public:
+	BucketQueue(void)
+	{
+	    m_nrKeys  = 0;
+	    m_minCost = 0;
+	}
+
+	virtual ~BucketQueue(void)
+	{
+	}
+
+	void Setup(const int nrKeys, const int nrBuckets)
+	{
+	    m_buckets.clear();
+	    m_buckets.resize(nrBuckets);
+	    m_pos.assign(nrKeys, -1);
+	    m_costs.resize(nrKeys);
+	    m_nrKeys  = 0;
+	    m_minCost = 0;
+	}
+
+	bool IsEmpty(void) const
+	{
+	    return m_nrKeys == 0;
+	}
+
+	int GetNrKeys(void) const
+	{
+	    return m_nrKeys;
+	}
+
+	bool HasKey(const int key) const
+	{
+	    return m_pos[key] >= 0;
+	}
+
+	int GetCost(const int key) const
+	{
+	    return m_costs[key];
+	}
+
+	void Insert(const int key, const int cost)
+	{
+	    std::vector<int> *bucket = &(m_buckets[cost % m_buckets.size()]);
+
+	    if(m_nrKeys == 0)
+		m_minCost = cost;
+	    m_pos[key]   = bucket->size();
+	    m_costs[key] = cost;
+	    bucket->push_back(key);
+	    ++m_nrKeys;
+	}
+
+	void Update(const int key, const int cost)
+	{
+	    Remove(key);
+	    Insert(key, cost);
+	}
+
+	void InsertOrUpdate(const int key, const int cost)
+	{
+	    if(HasKey(key))
+		Remove(key);
+	    Insert(key, cost);
+	}
+
+	int GetTop(void)
+	{
+	    return m_buckets[SkipEmptyBuckets()].back();
+	}
+
+	int GetTopCost(void)
+	{
+	    SkipEmptyBuckets();
+	    return m_minCost;
+	}
+
+	int RemoveTop(void)
+	{
+	    std::vector<int> *bucket = &(m_buckets[SkipEmptyBuckets()]);
+	    const int         key    = bucket->back();
+
+	    bucket->pop_back();
+	    m_pos[key] = -1;
+	    --m_nrKeys;
+
+	    return key;
+	}
+
+	void Remove(const int key)
+	{
+	    std::vector<int> *bucket = &(m_buckets[m_costs[key] % m_buckets.size()]);
+	    const int         last   = bucket->back();
+
+	    (*bucket)[m_pos[key]] = last;
+	    m_pos[last] = m_pos[key];
+	    bucket->pop_back();
+	    m_pos[key] = -1;
+	    --m_nrKeys;
+	}
+
+	void Clear(void)
+	{
+	    for(int i = 0; i < (int) m_buckets.size(); ++i)
+	    {
+		for(int j = 0; j < (int) m_buckets[i].size(); ++j)
+		    m_pos[m_buckets[i][j]] = -1;
+		m_buckets[i].clear();
+	    }
+	    m_nrKeys  = 0;
+	    m_minCost = 0;
+	}
+
+    protected:
+	int SkipEmptyBuckets(void)
+	{
+	    const int nb = m_buckets.size();
+	    int       b  = m_minCost % nb;
+
+	    while(m_buckets[b].empty())
+	    {
+		++m_minCost;
+		b = b + 1 == nb ? 0 : b + 1;
+	    }
+
+	    return b;
+	}
+
+	std::vector< std::vector<int> > m_buckets;
+	std::vector<int>                m_pos;
+	std::vector<int>                m_costs;
+	int                             m_nrKeys;
+	int                             m_minCost;
+    };
+}
+
+#endif
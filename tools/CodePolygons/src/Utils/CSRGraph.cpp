@@ -0,0 +1,91 @@
+#include "Utils/CSRGraph.hpp"
+
+namespace Abetare
+{
+    void CSRGraph::Setup(const int nrVertices, const int nrEdges,
+			 const int sources[], const int targets[], const double costs[])
+    {
+	//counting sort of the edges by source
+	m_offsets.assign(nrVertices + 1, 0);
+	for(int i = 0; i < nrEdges; ++i)
+	    ++m_offsets[sources[i] + 1];
+	for(int u = 0; u < nrVertices; ++u)
+	    m_offsets[u + 1] += m_offsets[u];
+
+	std::vector<int> pos(m_offsets.begin(), m_offsets.end() - 1);
+
+	m_targets.resize(nrEdges);
+	m_costs.resize(nrEdges);
+	for(int i = 0; i < nrEdges; ++i)
+	{
+	    const int e = pos[sources[i]]++;
+
+	    m_targets[e] = targets[i];
+	    m_costs[e]   = costs[i];
+	}
+    }
+
+    void CSRGraph::Setup(const int nrVertices, const GraphSearchInfo<int> * const info)
+    {
+	m_offsets.resize(nrVertices + 1);
+	m_targets.clear();
+	m_costs.clear();
+
+	m_offsets[0] = 0;
+	for(int u = 0; u < nrVertices; ++u)
+	{
+	    info->GetOutEdges(u, &m_targets, &m_costs);
+	    m_offsets[u + 1] = m_targets.size();
+	}
+    }
+
+    void CSRGraph::GetReverse(CSRGraph * const rgraph) const
+    {
+	const int        n = GetNrVertices();
+	std::vector<int> sources(GetNrEdges());
+
+	for(int u = 0; u < n; ++u)
+	    for(int e = m_offsets[u]; e < m_offsets[u + 1]; ++e)
+		sources[e] = u;
+	rgraph->Setup(n, GetNrEdges(), m_targets.data(), sources.data(), m_costs.data());
+    }
+
+    bool CSRGraph::Write(FILE * const out) const
+    {
+	const int sizes[2] = {GetNrVertices(), GetNrEdges()};
+
+	return
+	    fwrite(sizes, sizeof(int), 2, out) == 2 &&
+	    fwrite(m_offsets.data(), sizeof(int), sizes[0] + 1, out) == (size_t) (sizes[0] + 1) &&
+	    fwrite(m_targets.data(), sizeof(int), sizes[1], out) == (size_t) sizes[1] &&
+	    fwrite(m_costs.data(), sizeof(double), sizes[1], out) == (size_t) sizes[1];
+    }
+
+    bool CSRGraph::Read(FILE * const in)
+    {
+	int sizes[2];
+
+	if(fread(sizes, sizeof(int), 2, in) != 2 || sizes[0] < 0 || sizes[1] < 0)
+	    return false;
+
+	m_offsets.resize(sizes[0] + 1);
+	m_targets.resize(sizes[1]);
+	m_costs.resize(sizes[1]);
+
+	if(fread(m_offsets.data(), sizeof(int), sizes[0] + 1, in) != (size_t) (sizes[0] + 1) ||
+	   fread(m_targets.data(), sizeof(int), sizes[1], in) != (size_t) sizes[1] ||
+	   fread(m_costs.data(), sizeof(double), sizes[1], in) != (size_t) sizes[1] ||
+	   m_offsets[0] != 0 || m_offsets[sizes[0]] != sizes[1])
+	    return false;
+
+	//searches index by offsets and targets without checks
+	for(int u = 0; u < sizes[0]; ++u)
+	    if(m_offsets[u + 1] < m_offsets[u])
+		return false;
+	for(int e = 0; e < sizes[1]; ++e)
+	    if(m_targets[e] < 0 || m_targets[e] >= sizes[0])
+		return false;
+
+	return true;
+    }
+}
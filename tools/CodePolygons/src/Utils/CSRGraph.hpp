@@ -0,0 +1,122 @@
+#ifndef ABETARE__CSR_GRAPH_HPP_
+#define ABETARE__CSR_GRAPH_HPP_
+
+#include "Utils/GraphSearch.hpp"
+#include <vector>
+#include <cstdio>
+
+namespace Abetare
+{
+    /**
+     *@brief Directed graph with weighted edges in compressed sparse
+     *       row format
+     *
+     *@par Description:
+     *  Vertices are ids in <em>[0, nrVertices)</em>. The out edges of
+     *  vertex <em>u</em> are the edge ids in
+     *  <em>[GetFirstEdge(u), GetEndEdge(u))</em>, and their targets and
+     *  costs are stored contiguously, so traversals read memory in
+     *  order instead of calling <em>GetOutEdges</em> on each vertex.
+     */
+    class CSRGraph
+    {
+    public:
+	CSRGraph(void)
+	{
+	    m_offsets.push_back(0);
+	}
+
+	virtual ~CSRGraph(void)
+	{
+	}
+
+	/**
+	 *@brief Build the graph from a list of edges
+	 *       <em>(sources[i], targets[i])</em> with cost <em>costs[i]</em>
+	 *
+	 *@par Description:
+	 *  The out edges of each vertex keep their order in the list.
+	 */
+	virtual void Setup(const int nrVertices, const int nrEdges,
+			   const int sources[], const int targets[], const double costs[]);
+
+	/**
+	 *@brief Build the graph from the out edges given by
+	 *       <em>info</em> for the keys in <em>[0, nrVertices)</em>
+	 */
+	virtual void Setup(const int nrVertices, const GraphSearchInfo<int> * const info);
+
+	/**
+	 *@brief Get the graph with all the edges reversed, e.g., to search
+	 *       backward from a goal
+	 */
+	void GetReverse(CSRGraph * const rgraph) const;
+
+	/**
+	 *@brief Write the graph in binary format at the current position
+	 *       of <em>out</em>
+	 */
+	bool Write(FILE * const out) const;
+
+	/**
+	 *@brief Read a graph written by <em>Write</em>
+	 *
+	 *@returns false if the data cannot be read or does not describe a
+	 *         valid graph, i.e., offsets that decrease or end before or
+	 *         after the last edge, or targets that are not vertices
+	 */
+	bool Read(FILE * const in);
+
+	int GetNrVertices(void) const
+	{
+	    return m_offsets.size() - 1;
+	}
+
+	int GetNrEdges(void) const
+	{
+	    return m_targets.size();
+	}
+
+	int GetFirstEdge(const int u) const
+	{
+	    return m_offsets[u];
+	}
+
+	int GetEndEdge(const int u) const
+	{
+	    return m_offsets[u + 1];
+	}
+
+	int GetNrOutEdges(const int u) const
+	{
+	    return m_offsets[u + 1] - m_offsets[u];
+	}
+
+	int GetEdgeTarget(const int e) const
+	{
+	    return m_targets[e];
+	}
+
+	double GetEdgeCost(const int e) const
+	{
+	    return m_costs[e];
+	}
+
+	const int* GetEdgeTargets(void) const
+	{
+	    return m_targets.data();
+	}
+
+	const double* GetEdgeCosts(void) const
+	{
+	    return m_costs.data();
+	}
+
+    protected:
+	std::vector<int>    m_offsets;
+	std::vector<int>    m_targets;
+	std::vector<double> m_costs;
+    };
+}
+
+#endif
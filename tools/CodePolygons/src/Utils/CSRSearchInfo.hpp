@@ -0,0 +1,173 @@
+#ifndef ABETARE__CSR_SEARCH_INFO_HPP_
+#define ABETARE__CSR_SEARCH_INFO_HPP_
+
+#include "Utils/CSRGraph.hpp"
+#include "Utils/Constants.hpp"
+#include <vector>
+#include <cmath>
+
+namespace Abetare
+{
+    /**
+     *@brief Search over the vertices of a <em>CSRGraph</em>
+     *
+     *@par Description:
+     *  Besides the usual <em>GetOutEdges</em>, the edges of a vertex are
+     *  available as pointers into the graph arrays with
+     *  <em>GetOutEdgeSpan</em>, so nothing is copied per expansion.
+     *  <em>DenseGraphSearch::AStar</em> has an overload for this class
+     *  that uses the spans and calls the members below without going
+     *  through the virtual table.
+     *  \n\n
+     *  When vertex positions are given, the heuristics are the
+     *  Euclidean distances, which are consistent when each edge costs
+     *  at least the distance between its ends. Otherwise the heuristics
+     *  are zero.
+     */
+    class CSRSearchInfo : public GraphSearchInfo<int>
+    {
+    public:
+	CSRSearchInfo(void) : GraphSearchInfo<int>()
+	{
+	    m_graph  = NULL;
+	    m_rgraph = NULL;
+	    m_start  = Constants::ID_UNDEFINED;
+	    m_goal   = Constants::ID_UNDEFINED;
+	}
+
+	virtual ~CSRSearchInfo(void)
+	{
+	}
+
+	/**
+	 *@brief Set the graph and, for directed graphs, its reverse, which
+	 *       gives the in edges
+	 */
+	virtual void Setup(const CSRGraph * const graph, const CSRGraph * const rgraph = NULL)
+	{
+	    m_graph  = graph;
+	    m_rgraph = rgraph;
+	    m_points.clear();
+	}
+
+	/**
+	 *@brief Set the position <em>(points[2 * u], points[2 * u + 1])</em>
+	 *       of each vertex <em>u</em>, used by the heuristics
+	 */
+	void SetPoints(const double points[])
+	{
+	    m_points.assign(points, points + 2 * m_graph->GetNrVertices());
+	}
+
+	const CSRGraph* GetGraph(void) const
+	{
+	    return m_graph;
+	}
+
+	void SetStart(const int start)
+	{
+	    m_start = start;
+	}
+
+	int GetStart(void) const
+	{
+	    return m_start;
+	}
+
+	void SetGoal(const int goal)
+	{
+	    m_goal = goal;
+	}
+
+	int GetGoal(void) const
+	{
+	    return m_goal;
+	}
+
+	/**
+	 *@brief Set <em>targets</em> and <em>costs</em> to the out edges
+	 *       of <em>u</em> and return their number
+	 */
+	int GetOutEdgeSpan(const int u, const int ** const targets, const double ** const costs) const
+	{
+	    const int first = m_graph->GetFirstEdge(u);
+
+	    *targets = m_graph->GetEdgeTargets() + first;
+	    *costs   = m_graph->GetEdgeCosts() + first;
+
+	    return m_graph->GetEndEdge(u) - first;
+	}
+
+	int GetInEdgeSpan(const int v, const int ** const sources, const double ** const costs) const
+	{
+	    const CSRGraph * const graph = m_rgraph ? m_rgraph : m_graph;
+	    const int              first = graph->GetFirstEdge(v);
+
+	    *sources = graph->GetEdgeTargets() + first;
+	    *costs   = graph->GetEdgeCosts() + first;
+
+	    return graph->GetEndEdge(v) - first;
+	}
+
+	virtual void GetOutEdges(const int u,
+				 std::vector<int> * const edges,
+				 std::vector<double> * const costs = NULL) const
+	{
+	    const int    *targets;
+	    const double *tcosts;
+	    const int     n = GetOutEdgeSpan(u, &targets, &tcosts);
+
+	    edges->insert(edges->end(), targets, targets + n);
+	    if(costs)
+		costs->insert(costs->end(), tcosts, tcosts + n);
+	}
+
+	virtual void GetInEdges(const int v,
+				std::vector<int> * const edges,
+				std::vector<double> * const costs = NULL) const
+	{
+	    const int    *sources;
+	    const double *scosts;
+	    const int     n = GetInEdgeSpan(v, &sources, &scosts);
+
+	    edges->insert(edges->end(), sources, sources + n);
+	    if(costs)
+		costs->insert(costs->end(), scosts, scosts + n);
+	}
+
+	virtual bool IsGoal(const int key) const
+	{
+	    return key == m_goal;
+	}
+
+	virtual double HeuristicCostToGoal(const int u) const
+	{
+	    return EuclideanDistance(u, m_goal);
+	}
+
+	virtual double HeuristicCostFromStart(const int u) const
+	{
+	    return EuclideanDistance(m_start, u);
+	}
+
+	double EuclideanDistance(const int u, const int v) const
+	{
+	    if(m_points.empty())
+		return 0;
+
+	    const double dx = m_points[2 * u]     - m_points[2 * v];
+	    const double dy = m_points[2 * u + 1] - m_points[2 * v + 1];
+
+	    return sqrt(dx * dx + dy * dy);
+	}
+
+    protected:
+	const CSRGraph     *m_graph;
+	const CSRGraph     *m_rgraph;
+	std::vector<double> m_points;
+	int                 m_start;
+	int                 m_goal;
+    };
+}
+
+#endif
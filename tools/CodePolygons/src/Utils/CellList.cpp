@@ -0,0 +1,177 @@
+#include "Utils/CellList.hpp"
+#include <queue>
+#include <cmath>
+
+namespace Abetare
+{
+    void CellList::Rebuild(const int n, const double pts[])
+    {
+	const int ncells = m_grid->GetNrCells();
+
+	m_cells.resize(n);
+	m_ids.resize(n);
+	m_pts.resize(n * m_ndims);
+	m_cellStarts.assign(ncells + 1, 0);
+
+	//counting sort by cell id
+	for(int i = 0; i < n; ++i)
+	{
+	    m_cells[i] = m_grid->GetCellId(&pts[i * m_ndims]);
+	    ++m_cellStarts[m_cells[i] + 1];
+	}
+	for(int i = 0; i < ncells; ++i)
+	    m_cellStarts[i + 1] += m_cellStarts[i];
+	for(int i = 0; i < n; ++i)
+	{
+	    const int pos = m_cellStarts[m_cells[i]]++;
+
+	    m_ids[pos] = i;
+	    for(int j = 0; j < m_ndims; ++j)
+		m_pts[pos * m_ndims + j] = pts[i * m_ndims + j];
+	}
+
+	//the counts were advanced to the end of each cell, so shift them back
+	for(int i = ncells; i > 0; --i)
+	    m_cellStarts[i] = m_cellStarts[i - 1];
+	m_cellStarts[0] = 0;
+    }
+
+    void CellList::GetNeighsInRadius(const double p[],
+				     const double r,
+				     std::vector<int> * const neighs,
+				     const int exclude) const
+    {
+	const int *dims = m_grid->GetDims();
+	const double rr = r * r;
+	double       q[3];
+	int          lo[3], hi[3], c[3];
+
+	for(int i = 0; i < m_ndims; ++i)
+	    q[i] = p[i] - r;
+	m_grid->GetCoords(q, lo);
+	for(int i = 0; i < m_ndims; ++i)
+	    q[i] = p[i] + r;
+	m_grid->GetCoords(q, hi);
+
+	for(int i = 0; i < m_ndims; ++i)
+	    c[i] = lo[i];
+
+	while(true)
+	{
+	    int id = 0;
+	    for(int i = m_ndims - 1; i >= 0; --i)
+		id = id * dims[i] + c[i];
+
+	    const int end = m_cellStarts[id + 1];
+	    for(int pos = m_cellStarts[id]; pos < end; ++pos)
+		if(m_ids[pos] != exclude && DistSquared(p, pos) <= rr)
+		    neighs->push_back(m_ids[pos]);
+
+	    int i = 0;
+	    for(; i < m_ndims; ++i)
+	    {
+		if(++c[i] <= hi[i])
+		    break;
+		c[i] = lo[i];
+	    }
+	    if(i == m_ndims)
+		break;
+	}
+    }
+
+    void CellList::GetKNearest(const double p[],
+			       const int k,
+			       std::vector<int> * const neighs,
+			       std::vector<double> * const dists,
+			       const int exclude) const
+    {
+	const int    *dims  = m_grid->GetDims();
+	const double *units = m_grid->GetUnits();
+	double        umin  = units[0];
+	int           pc[3], lo[3], hi[3], c[3];
+
+	std::priority_queue< std::pair<double, int> > best;
+
+	if(k <= 0)
+	    return;
+
+	for(int i = 1; i < m_ndims; ++i)
+	    if(units[i] < umin)
+		umin = units[i];
+
+	m_grid->GetCoords(p, pc);
+
+	for(int d = 0; ; ++d)
+	{
+	    bool whole = true;
+
+	    for(int i = 0; i < m_ndims; ++i)
+	    {
+		lo[i] = pc[i] - d < 0 ? 0 : pc[i] - d;
+		hi[i] = pc[i] + d >= dims[i] ? dims[i] - 1 : pc[i] + d;
+		c[i]  = lo[i];
+		whole = whole && lo[i] == 0 && hi[i] == dims[i] - 1;
+	    }
+
+	    //visit only the cells on the ring at Chebyshev distance d
+	    while(true)
+	    {
+		bool ring = false;
+		int  id   = 0;
+
+		for(int i = m_ndims - 1; i >= 0; --i)
+		{
+		    id   = id * dims[i] + c[i];
+		    ring = ring || c[i] == pc[i] - d || c[i] == pc[i] + d;
+		}
+
+		if(ring)
+		{
+		    const int end = m_cellStarts[id + 1];
+		    for(int pos = m_cellStarts[id]; pos < end; ++pos)
+			if(m_ids[pos] != exclude)
+			{
+			    const double dd = DistSquared(p, pos);
+
+			    if((int) best.size() < k)
+				best.push(std::make_pair(dd, m_ids[pos]));
+			    else if(dd < best.top().first)
+			    {
+				best.pop();
+				best.push(std::make_pair(dd, m_ids[pos]));
+			    }
+			}
+		}
+
+		int i = 0;
+		for(; i < m_ndims; ++i)
+		{
+		    if(++c[i] <= hi[i])
+			break;
+		    c[i] = lo[i];
+		}
+		if(i == m_ndims)
+		    break;
+	    }
+
+	    //cells beyond ring d are at least d * umin away from p
+	    if(whole || ((int) best.size() == k && best.top().first <= (d * umin) * (d * umin)))
+		break;
+	}
+
+	const int n      = best.size();
+	const int start  = neighs->size();
+	const int dstart = dists ? dists->size() : 0;
+
+	neighs->resize(start + n);
+	if(dists)
+	    dists->resize(dstart + n);
+	for(int i = n - 1; i >= 0; --i)
+	{
+	    (*neighs)[start + i] = best.top().second;
+	    if(dists)
+		(*dists)[dstart + i] = sqrt(best.top().first);
+	    best.pop();
+	}
+    }
+}
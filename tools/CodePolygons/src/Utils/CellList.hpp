@@ -0,0 +1,112 @@
+#ifndef ABETARE__CELL_LIST_HPP_
+#define ABETARE__CELL_LIST_HPP_
+
+#include "Utils/Grid.hpp"
+#include <vector>
+#include <cstdlib>
+
+namespace Abetare
+{
+    /**
+     *@brief Uniform cell list for neighbor queries among moving points
+     *
+     *@par Description:
+     *  Points are bucketed by <em>Grid</em> cell id with a counting
+     *  sort, so a rebuild costs <em>O(N + number of cells)</em> and can
+     *  be done at every simulation step. The point ids and positions
+     *  are stored contiguously in cell order, which keeps the
+     *  radius and k-nearest queries cache friendly. Points outside the
+     *  grid are placed in the border cells. Grids of up to three
+     *  dimensions are supported.
+     */
+    class CellList
+    {
+    public:
+	CellList(void)
+	{
+	    m_grid  = NULL;
+	    m_ndims = 0;
+	}
+
+	virtual ~CellList(void)
+	{
+	}
+
+	virtual void Setup(const Grid * const grid)
+	{
+	    m_grid  = grid;
+	    m_ndims = grid->GetNrDims();
+	    m_cellStarts.assign(grid->GetNrCells() + 1, 0);
+	}
+
+	/**
+	 *@brief Bucket the points
+	 *
+	 *@param n   number of points
+	 *@param pts coordinates of the points, stored one after the other
+	 */
+	virtual void Rebuild(const int n, const double pts[]);
+
+	int GetNrPoints(void) const
+	{
+	    return m_ids.size();
+	}
+
+	const Grid* GetGrid(void) const
+	{
+	    return m_grid;
+	}
+
+	/**
+	 *@brief Get the ids of the points in cell <em>id</em>
+	 */
+	const int* GetCellPoints(const int id, int * const n) const
+	{
+	    *n = m_cellStarts[id + 1] - m_cellStarts[id];
+	    return &(m_ids[m_cellStarts[id]]);
+	}
+
+	/**
+	 *@brief Get the points within distance <em>r</em> from <em>p</em>
+	 *
+	 *@param exclude point id to leave out, e.g., the querying agent
+	 */
+	void GetNeighsInRadius(const double p[],
+			       const double r,
+			       std::vector<int> * const neighs,
+			       const int exclude = -1) const;
+
+	/**
+	 *@brief Get the <em>k</em> points nearest to <em>p</em>, ordered
+	 *       by increasing distance
+	 *
+	 *@param dists if not NULL, set to the corresponding distances
+	 *@param exclude point id to leave out, e.g., the querying agent
+	 */
+	void GetKNearest(const double p[],
+			 const int k,
+			 std::vector<int> * const neighs,
+			 std::vector<double> * const dists = NULL,
+			 const int exclude = -1) const;
+
+    protected:
+	double DistSquared(const double p[], const int pos) const
+	{
+	    const double *q = &(m_pts[pos * m_ndims]);
+	    double        d = 0;
+
+	    for(int i = 0; i < m_ndims; ++i)
+		d += (p[i] - q[i]) * (p[i] - q[i]);
+	    return d;
+	}
+
+	const Grid         *m_grid;
+	int                 m_ndims;
+	std::vector<int>    m_cellStarts;
+	std::vector<int>    m_ids;
+	std::vector<double> m_pts;
+	std::vector<int>    m_cells;
+    };
+}
+
+#endif
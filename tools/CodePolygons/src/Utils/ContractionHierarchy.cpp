@@ -0,0 +1,517 @@
+#include "Utils/ContractionHierarchy.hpp"
+#include "Utils/PrintMsg.hpp"
+#include "Utils/Misc.hpp"
+#include "Utils/Constants.hpp"
+#include <cstring>
+
+namespace Abetare
+{
+    /**
+     *@brief Add arc <em>(u, w)</em> or lower the cost of the existing one
+     */
+    template <typename Arc>
+    static void ContractionHierarchyAddArc(const int u, const int w, const double cost, const int middle,
+					   std::vector<std::vector<Arc> > * const outs,
+					   std::vector<std::vector<Arc> > * const ins)
+    {
+	std::vector<Arc> & out = (*outs)[u];
+	std::vector<Arc> & in  = (*ins)[w];
+
+	for(int i = 0; i < (int) out.size(); ++i)
+	    if(out[i].m_vertex == w)
+	    {
+		if(cost < out[i].m_cost)
+		{
+		    out[i].m_cost   = cost;
+		    out[i].m_middle = middle;
+		    for(int j = 0; j < (int) in.size(); ++j)
+			if(in[j].m_vertex == u)
+			{
+			    in[j].m_cost   = cost;
+			    in[j].m_middle = middle;
+			}
+		}
+		return;
+	    }
+
+	Arc arc;
+
+	arc.m_cost   = cost;
+	arc.m_middle = middle;
+	arc.m_vertex = w;
+	out.push_back(arc);
+	arc.m_vertex = u;
+	in.push_back(arc);
+    }
+
+    template <typename Arc>
+    static void ContractionHierarchyRemoveArc(const int u, std::vector<Arc> * const arcs)
+    {
+	for(int i = 0; i < (int) arcs->size(); ++i)
+	    if((*arcs)[i].m_vertex == u)
+	    {
+		(*arcs)[i] = arcs->back();
+		arcs->pop_back();
+		return;
+	    }
+    }
+
+    void ContractionHierarchy::NewStamp(void)
+    {
+	if(++m_stamp == 0)
+	{
+	    m_stamps[0].assign(m_stamps[0].size(), 0);
+	    m_stamps[1].assign(m_stamps[1].size(), 0);
+	    m_stamp = 1;
+	}
+    }
+
+    void ContractionHierarchy::WitnessSearch(const int u, const int v, const double maxCost, int nrTargets,
+					     const std::vector<std::vector<Arc> > & outs)
+    {
+	std::vector<double>       & dists     = m_dists[0];
+	std::vector<unsigned int> & stamps    = m_stamps[0];
+	DaryHeap<4>               & heap      = m_heaps[0];
+	int                         nrSettled = 0;
+
+	heap.Clear();
+	stamps[u] = m_stamp;
+	dists[u]  = 0;
+	heap.Insert(u, 0);
+
+	//stop once the targets, marked in the backward stamps, are all settled
+	while(!heap.IsEmpty() && nrTargets > 0 && heap.GetTopCost() <= maxCost && ++nrSettled <= m_witnessLimit)
+	{
+	    const int    x  = heap.RemoveTop();
+	    const double dx = dists[x];
+
+	    if(m_stamps[1][x] == m_stamp)
+		--nrTargets;
+
+	    for(int i = 0; i < (int) outs[x].size(); ++i)
+	    {
+		const int    y  = outs[x][i].m_vertex;
+		const double dy = dx + outs[x][i].m_cost;
+
+		if(y == v || m_contracted[y])
+		    continue;
+		if(stamps[y] != m_stamp || dy < dists[y])
+		{
+		    stamps[y] = m_stamp;
+		    dists[y]  = dy;
+		    heap.InsertOrUpdate(y, dy);
+		}
+	    }
+	}
+    }
+
+    void ContractionHierarchy::Contract(const int v, const bool simulate, int * const nrShortcuts,
+					std::vector<std::vector<Arc> > * const outs,
+					std::vector<std::vector<Arc> > * const ins)
+    {
+	const std::vector<Arc> & in  = (*ins)[v];
+	const std::vector<Arc> & out = (*outs)[v];
+
+	*nrShortcuts = 0;
+	for(int i = 0; i < (int) in.size(); ++i)
+	{
+	    const int    u         = in[i].m_vertex;
+	    const double cuv       = in[i].m_cost;
+	    double       maxCost   = -1;
+	    int          nrTargets = 0;
+
+	    if(m_contracted[u])
+		continue;
+	    NewStamp();
+	    for(int j = 0; j < (int) out.size(); ++j)
+		if(!m_contracted[out[j].m_vertex] && out[j].m_vertex != u)
+		{
+		    m_stamps[1][out[j].m_vertex] = m_stamp;
+		    ++nrTargets;
+		    if(cuv + out[j].m_cost > maxCost)
+			maxCost = cuv + out[j].m_cost;
+		}
+	    if(nrTargets == 0)
+		continue;
+
+	    WitnessSearch(u, v, maxCost, nrTargets, *outs);
+	    for(int j = 0; j < (int) out.size(); ++j)
+	    {
+		const int    w = out[j].m_vertex;
+		const double c = cuv + out[j].m_cost;
+
+		if(m_contracted[w] || w == u)
+		    continue;
+		if(m_stamps[0][w] == m_stamp && m_dists[0][w] <= c)
+		    continue;
+
+		++(*nrShortcuts);
+		if(!simulate)
+		    ContractionHierarchyAddArc<Arc>(u, w, c, v, outs, ins);
+	    }
+	}
+    }
+
+    double ContractionHierarchy::GetPriority(const int v,
+					     std::vector<std::vector<Arc> > * const outs,
+					     std::vector<std::vector<Arc> > * const ins)
+    {
+	int nrShortcuts;
+
+	Contract(v, true, &nrShortcuts, outs, ins);
+
+	return nrShortcuts - (int) ((*outs)[v].size() + (*ins)[v].size()) + m_nrContractedNeighs[v] + m_levels[v];
+    }
+
+    void ContractionHierarchy::Setup(const CSRGraph * const graph)
+    {
+	const int                      n = graph->GetNrVertices();
+	std::vector<std::vector<Arc> > outs(n);
+	std::vector<std::vector<Arc> > ins(n);
+	std::vector<std::vector<Arc> > ups(n);
+	std::vector<std::vector<Arc> > downs(n);
+	DaryHeap<4>                    order;
+	int                            nrShortcuts;
+
+	for(int u = 0; u < n; ++u)
+	    for(int e = graph->GetFirstEdge(u); e < graph->GetEndEdge(u); ++e)
+		if(graph->GetEdgeTarget(e) != u)
+		    ContractionHierarchyAddArc<Arc>(u, graph->GetEdgeTarget(e), graph->GetEdgeCost(e), -1, &outs, &ins);
+
+	m_ranks.assign(n, -1);
+	m_contracted.assign(n, 0);
+	m_nrContractedNeighs.assign(n, 0);
+	m_levels.assign(n, 0);
+	for(int d = 0; d < 2; ++d)
+	{
+	    m_dists[d].resize(n);
+	    m_parents[d].resize(n);
+	    m_stamps[d].assign(n, 0);
+	    m_heaps[d].Setup(n);
+	}
+	m_stamp = 0;
+
+	order.Setup(n);
+	for(int v = 0; v < n; ++v)
+	    order.Insert(v, GetPriority(v, &outs, &ins));
+
+	for(int rank = 0; !order.IsEmpty(); ++rank)
+	{
+	    int v = order.RemoveTop();
+
+	    //priorities of the remaining vertices are stale, so re-evaluate
+	    //the top one and put it back if it is no longer the least
+	    for(double p; !order.IsEmpty() && (p = GetPriority(v, &outs, &ins)) > order.GetTopCost();)
+	    {
+		order.Insert(v, p);
+		v = order.RemoveTop();
+	    }
+
+	    Contract(v, false, &nrShortcuts, &outs, &ins);
+	    m_ranks[v]      = rank;
+	    m_contracted[v] = 1;
+	    ups[v].swap(outs[v]);
+	    downs[v].swap(ins[v]);
+
+	    //drop the arcs to v from its neighbors
+	    for(int k = 0; k < 2; ++k)
+	    {
+		const std::vector<Arc> & arcs = k == 0 ? ups[v] : downs[v];
+
+		for(int i = 0; i < (int) arcs.size(); ++i)
+		{
+		    const int w = arcs[i].m_vertex;
+
+		    ContractionHierarchyRemoveArc<Arc>(v, &((k == 0 ? ins : outs)[w]));
+		    ++m_nrContractedNeighs[w];
+		    if(m_levels[w] < m_levels[v] + 1)
+			m_levels[w] = m_levels[v] + 1;
+		}
+	    }
+	}
+
+	//edges are grouped by vertex in id order, so the middles follow the edge ids
+	std::vector<int>    sources, targets;
+	std::vector<double> costs;
+
+	for(int k = 0; k < 2; ++k)
+	{
+	    const std::vector<std::vector<Arc> > & arcs    = k == 0 ? ups : downs;
+	    std::vector<int>                     & middles = k == 0 ? m_upMiddles : m_downMiddles;
+
+	    sources.clear();
+	    targets.clear();
+	    costs.clear();
+	    middles.clear();
+	    for(int u = 0; u < n; ++u)
+		for(int i = 0; i < (int) arcs[u].size(); ++i)
+		{
+		    sources.push_back(u);
+		    targets.push_back(arcs[u][i].m_vertex);
+		    costs.push_back(arcs[u][i].m_cost);
+		    middles.push_back(arcs[u][i].m_middle);
+		}
+	    (k == 0 ? m_up : m_down).Setup(n, sources.size(), sources.data(), targets.data(), costs.data());
+	}
+	std::vector<char>().swap(m_contracted);
+	std::vector<int>().swap(m_nrContractedNeighs);
+	std::vector<int>().swap(m_levels);
+    }
+
+    int ContractionHierarchy::GetNrShortcuts(void) const
+    {
+	int count = 0;
+
+	for(int i = 0; i < (int) m_upMiddles.size(); ++i)
+	    count += m_upMiddles[i] >= 0;
+	for(int i = 0; i < (int) m_downMiddles.size(); ++i)
+	    count += m_downMiddles[i] >= 0;
+
+	return count;
+    }
+
+    bool ContractionHierarchy::Write(const char fname[]) const
+    {
+	FILE *out = fopen(fname, "wb");
+
+	if(out == NULL)
+	{
+	    PrintError(printf("could not open file <%s> for writing\n", fname));
+	    return false;
+	}
+
+	const int  n     = GetNrVertices();
+	const int  nup   = m_upMiddles.size();
+	const int  ndown = m_downMiddles.size();
+	const bool ok    =
+	    fwrite("ABCH", 1, 4, out) == 4 &&
+	    fwrite(&n, sizeof(int), 1, out) == 1 &&
+	    fwrite(m_ranks.data(), sizeof(int), n, out) == (size_t) n &&
+	    m_up.Write(out) &&
+	    fwrite(m_upMiddles.data(), sizeof(int), nup, out) == (size_t) nup &&
+	    m_down.Write(out) &&
+	    fwrite(m_downMiddles.data(), sizeof(int), ndown, out) == (size_t) ndown;
+
+	fclose(out);
+	if(!ok)
+	{
+	    PrintError(printf("could not write file <%s>\n", fname));
+	}
+
+	return ok;
+    }
+
+    /**
+     *@brief Check that the edges of <em>graph</em> lead to higher ranks
+     *       and that their middles are lower-ranked than both ends, so
+     *       searches stay upward and unpacking terminates
+     */
+    static bool ContractionHierarchyIsUpward(const CSRGraph & graph,
+					     const std::vector<int> & middles,
+					     const std::vector<int> & ranks)
+    {
+	const int n = ranks.size();
+
+	for(int u = 0; u < n; ++u)
+	    for(int e = graph.GetFirstEdge(u); e < graph.GetEndEdge(u); ++e)
+	    {
+		const int w = graph.GetEdgeTarget(e);
+		const int m = middles[e];
+
+		if(ranks[w] <= ranks[u])
+		    return false;
+		if(m >= 0 && (m >= n || ranks[m] >= ranks[u]))
+		    return false;
+	    }
+	return true;
+    }
+
+    bool ContractionHierarchy::Read(const char fname[])
+    {
+	FILE *in = fopen(fname, "rb");
+	char  magic[4];
+	int   n  = 0;
+
+	if(in == NULL)
+	{
+	    PrintError(printf("could not open file <%s> for reading\n", fname));
+	    return false;
+	}
+
+	bool ok =
+	    fread(magic, 1, 4, in) == 4 && memcmp(magic, "ABCH", 4) == 0 &&
+	    fread(&n, sizeof(int), 1, in) == 1 && n >= 0;
+
+	if(ok)
+	{
+	    m_ranks.resize(n);
+	    ok = fread(m_ranks.data(), sizeof(int), n, in) == (size_t) n && m_up.Read(in);
+	}
+	if(ok)
+	{
+	    m_upMiddles.resize(m_up.GetNrEdges());
+	    ok = fread(m_upMiddles.data(), sizeof(int), m_upMiddles.size(), in) == m_upMiddles.size() && m_down.Read(in);
+	}
+	if(ok)
+	{
+	    m_downMiddles.resize(m_down.GetNrEdges());
+	    ok = fread(m_downMiddles.data(), sizeof(int), m_downMiddles.size(), in) == m_downMiddles.size() &&
+		m_up.GetNrVertices() == n && m_down.GetNrVertices() == n;
+	}
+	fclose(in);
+
+	//the ranks must be a permutation of the vertices
+	if(ok)
+	{
+	    std::vector<char> seen(n, 0);
+
+	    for(int v = 0; v < n && ok; ++v)
+	    {
+		ok = m_ranks[v] >= 0 && m_ranks[v] < n && !seen[m_ranks[v]];
+		if(ok)
+		    seen[m_ranks[v]] = 1;
+	    }
+	}
+	ok = ok &&
+	    ContractionHierarchyIsUpward(m_up, m_upMiddles, m_ranks) &&
+	    ContractionHierarchyIsUpward(m_down, m_downMiddles, m_ranks);
+
+	if(!ok)
+	{
+	    PrintError(printf("invalid contraction hierarchy file <%s>\n", fname));
+	    m_ranks.clear();
+	    return false;
+	}
+
+	for(int d = 0; d < 2; ++d)
+	{
+	    m_dists[d].resize(n);
+	    m_parents[d].resize(n);
+	    m_stamps[d].assign(n, 0);
+	    m_heaps[d].Setup(n);
+	}
+	m_stamp = 0;
+
+	return true;
+    }
+
+    void ContractionHierarchy::SettleUp(const bool forward, double * const mu, int * const meet)
+    {
+	const int        d     = forward ? 0 : 1;
+	const int        o     = 1 - d;
+	const CSRGraph & graph = forward ? m_up : m_down;
+	const int        x     = m_heaps[d].RemoveTop();
+	const double     dx    = m_dists[d][x];
+	const int        end   = graph.GetEndEdge(x);
+
+	++m_nrSettled;
+	for(int e = graph.GetFirstEdge(x); e < end; ++e)
+	{
+	    const int    y  = graph.GetEdgeTarget(e);
+	    const double dy = dx + graph.GetEdgeCost(e);
+
+	    if(m_stamps[d][y] == m_stamp && !(dy < m_dists[d][y]))
+		continue;
+
+	    m_stamps[d][y]  = m_stamp;
+	    m_dists[d][y]   = dy;
+	    m_parents[d][y] = x;
+	    m_heaps[d].InsertOrUpdate(y, dy);
+
+	    if(m_stamps[o][y] == m_stamp && dy + m_dists[o][y] < *mu)
+	    {
+		*mu   = dy + m_dists[o][y];
+		*meet = y;
+	    }
+	}
+    }
+
+    double ContractionHierarchy::Query(const int start, const int goal)
+    {
+	double mu = HUGE_VAL;
+
+	NewStamp();
+	m_start     = start;
+	m_goal      = goal;
+	m_meet      = Constants::ID_UNDEFINED;
+	m_nrSettled = 0;
+
+	const int ends[2] = {start, goal};
+
+	for(int d = 0; d < 2; ++d)
+	{
+	    m_heaps[d].Clear();
+	    m_stamps[d][ends[d]]  = m_stamp;
+	    m_dists[d][ends[d]]   = 0;
+	    m_parents[d][ends[d]] = ends[d];
+	    m_heaps[d].Insert(ends[d], 0);
+	}
+	if(start == goal)
+	{
+	    m_meet = start;
+	    return 0;
+	}
+
+	//a direction stops once its minimum key reaches the best cost
+	for(;;)
+	{
+	    const double minf = m_heaps[0].IsEmpty() ? HUGE_VAL : m_heaps[0].GetTopCost();
+	    const double minb = m_heaps[1].IsEmpty() ? HUGE_VAL : m_heaps[1].GetTopCost();
+
+	    if(minf >= mu && minb >= mu)
+		break;
+	    SettleUp(minf <= minb, &mu, &m_meet);
+	}
+
+	return mu;
+    }
+
+    int ContractionHierarchy::FindEdge(const CSRGraph & graph, const std::vector<int> & middles,
+				       const int u, const int w) const
+    {
+	const int end = graph.GetEndEdge(u);
+
+	for(int e = graph.GetFirstEdge(u); e < end; ++e)
+	    if(graph.GetEdgeTarget(e) == w)
+		return middles[e];
+
+	return Constants::ID_UNDEFINED;
+    }
+
+    void ContractionHierarchy::Unpack(const int u, const int w, std::vector<int> * const path) const
+    {
+	//upward edges are stored at their lower end
+	const int middle = m_ranks[u] < m_ranks[w] ?
+	    FindEdge(m_up, m_upMiddles, u, w) : FindEdge(m_down, m_downMiddles, w, u);
+
+	if(middle < 0)
+	    path->push_back(w);
+	else
+	{
+	    Unpack(u, middle, path);
+	    Unpack(middle, w, path);
+	}
+    }
+
+    void ContractionHierarchy::GetPath(std::vector<int> * const path) const
+    {
+	std::vector<int> vertices;
+
+	if(m_meet == Constants::ID_UNDEFINED)
+	    return;
+
+	for(int x = m_meet; x != m_start; x = m_parents[0][x])
+	    vertices.push_back(x);
+	vertices.push_back(m_start);
+	ReverseItems<int>(&vertices);
+	for(int x = m_meet; x != m_goal;)
+	{
+	    x = m_parents[1][x];
+	    vertices.push_back(x);
+	}
+
+	path->push_back(vertices[0]);
+	for(int i = 1; i < (int) vertices.size(); ++i)
+	    Unpack(vertices[i - 1], vertices[i], path);
+    }
+}
@@ -0,0 +1,162 @@
+#ifndef ABETARE__CONTRACTION_HIERARCHY_HPP_
+#define ABETARE__CONTRACTION_HIERARCHY_HPP_
+
+#include "Utils/CSRGraph.hpp"
+#include "Utils/DaryHeap.hpp"
+#include <vector>
+#include <cmath>
+
+namespace Abetare
+{
+    /**
+     *@brief Contraction hierarchy for shortest-path queries over a
+     *       static weighted graph
+     *
+     *@par Description:
+     *  Preprocessing contracts the vertices one at a time, least
+     *  important first, by edge difference plus number of contracted
+     *  neighbors, with stale priorities re-evaluated when they reach the
+     *  top of the queue. Contracting <em>v</em> adds a shortcut
+     *  <em>(u, w)</em> for each pair of in and out neighbors whose
+     *  shortest path goes through <em>v</em>, which is checked by a
+     *  bounded local search, the witness search. A query then runs
+     *  Dijkstra from both ends over the edges that lead to higher-ranked
+     *  vertices only, which settles a few hundred vertices even on large
+     *  graphs. Shortcuts remember the contracted vertex, so paths are
+     *  unpacked into edges of the original graph.
+     *  \n\n
+     *  Preprocessing depends only on the graph, so it is done once per
+     *  roadmap and saved with <em>Write</em>.
+     */
+    class ContractionHierarchy
+    {
+    public:
+	ContractionHierarchy(void)
+	{
+	    m_witnessLimit = 500;
+	    m_stamp        = 0;
+	    m_nrSettled    = 0;
+	}
+
+	virtual ~ContractionHierarchy(void)
+	{
+	}
+
+	/**
+	 *@brief Maximum number of vertices settled by a witness search;
+	 *       lower values speed up preprocessing but add shortcuts
+	 */
+	int m_witnessLimit;
+
+	/**
+	 *@brief Contract all the vertices of <em>graph</em>
+	 */
+	virtual void Setup(const CSRGraph * const graph);
+
+	bool Write(const char fname[]) const;
+
+	bool Read(const char fname[]);
+
+	int GetNrVertices(void) const
+	{
+	    return m_ranks.size();
+	}
+
+	int GetRank(const int u) const
+	{
+	    return m_ranks[u];
+	}
+
+	/**
+	 *@brief Number of shortcuts added by the preprocessing
+	 */
+	int GetNrShortcuts(void) const;
+
+	/**
+	 *@brief Cost of a shortest path from <em>start</em> to
+	 *       <em>goal</em>, or <em>HUGE_VAL</em> if there is none
+	 */
+	double Query(const int start, const int goal);
+
+	/**
+	 *@brief Vertices of the path found by the last query, in the
+	 *       original graph
+	 */
+	void GetPath(std::vector<int> * const path) const;
+
+	/**
+	 *@brief Number of vertices settled by the last query
+	 */
+	int GetNrSettled(void) const
+	{
+	    return m_nrSettled;
+	}
+
+    protected:
+	struct Arc
+	{
+	    int    m_vertex;
+	    double m_cost;
+	    int    m_middle;
+	};
+
+	/**
+	 *@brief Edge difference plus number of contracted neighbors plus
+	 *       level in the hierarchy, so that contractions spread evenly
+	 */
+	double GetPriority(const int v,
+			   std::vector<std::vector<Arc> > * const outs,
+			   std::vector<std::vector<Arc> > * const ins);
+
+	void Contract(const int v, const bool simulate, int * const nrShortcuts,
+		      std::vector<std::vector<Arc> > * const outs,
+		      std::vector<std::vector<Arc> > * const ins);
+
+	/**
+	 *@brief Local search from <em>u</em> that avoids <em>v</em> and
+	 *       the contracted vertices and stops beyond <em>maxCost</em>
+	 *       or when the <em>nrTargets</em> targets are settled
+	 */
+	void WitnessSearch(const int u, const int v, const double maxCost, int nrTargets,
+			   const std::vector<std::vector<Arc> > & outs);
+
+	void NewStamp(void);
+
+	/**
+	 *@brief Expand the shortcut <em>(u, w)</em> into the original
+	 *       vertices after <em>u</em>
+	 */
+	void Unpack(const int u, const int w, std::vector<int> * const path) const;
+
+	int FindEdge(const CSRGraph & graph, const std::vector<int> & middles, const int u, const int w) const;
+
+	void SettleUp(const bool forward, double * const mu, int * const meet);
+
+	std::vector<int>          m_ranks;
+
+	/**
+	 *@brief Edges to higher-ranked vertices, and reversed edges from
+	 *       higher-ranked vertices, with the contracted vertex of each
+	 *       shortcut or -1
+	 */
+	CSRGraph                  m_up;
+	CSRGraph                  m_down;
+	std::vector<int>          m_upMiddles;
+	std::vector<int>          m_downMiddles;
+
+	std::vector<char>         m_contracted;
+	std::vector<int>          m_nrContractedNeighs;
+	std::vector<int>          m_levels;
+	std::vector<double>       m_dists[2];
+	std::vector<int>          m_parents[2];
+	std::vector<unsigned int> m_stamps[2];
+	DaryHeap<4>               m_heaps[2];
+	unsigned int              m_stamp;
+	int                       m_start;
+	int                       m_goal;
+	int                       m_meet;
+	int                       m_nrSettled;
+    };
+}
+
+#endif
@@ -0,0 +1,349 @@
+#ifndef ABETARE__DSTAR_LITE_HPP_
+#define ABETARE__DSTAR_LITE_HPP_
+
+#include "Utils/GraphSearch.hpp"
+#include "Utils/Map.hpp"
+#include "Utils/Heap.hpp"
+#include "Utils/Constants.hpp"
+#include <vector>
+#include <cmath>
+
+namespace Abetare
+{
+    /**
+     *@brief Incremental replanning with D* Lite
+     *
+     *@par Description:
+     *  The search runs backward from the goal, following
+     *  <em>GetInEdges</em>, and keeps its g-values and open list between
+     *  calls to <em>ComputeShortestPath</em>. When edge costs change or
+     *  the start moves, only the keys whose cost-to-goal is affected are
+     *  expanded again, instead of searching from scratch. If the start
+     *  never moves, this is LPA* run from the goal.
+     *  \n\n
+     *  The heuristic is <em>m_info->HeuristicCostFromStart</em>, which
+     *  must be consistent and symmetric. The info must report the current
+     *  start, so update it before calling <em>MoveStart</em>.
+     */
+    template <typename Key>
+    class DStarLite
+    {
+    public:
+	DStarLite(void)
+	{
+	    m_heap.m_lessFn     = LessFn;
+	    m_heap.m_lessFnData = &m_map;
+	    m_info              = NULL;
+	    m_km                = 0;
+	    m_nrExpansions      = 0;
+	}
+
+	virtual ~DStarLite(void)
+	{
+	}
+
+	GraphSearchInfo<Key> *m_info;
+
+	/**
+	 *@brief Discard the previous search tree and plan from
+	 *       <em>start</em> to <em>goal</em>
+	 */
+	void Initialize(const Key start, const Key goal);
+
+	/**
+	 *@brief Expand keys until the cost from the start is correct
+	 *
+	 *@returns true if the goal can be reached from the start
+	 */
+	bool ComputeShortestPath(void);
+
+	/**
+	 *@brief Move the start, e.g., as the agent follows the path
+	 */
+	void MoveStart(const Key start)
+	{
+	    m_km   += m_info->HeuristicCostFromStart(m_start);
+	    m_start = start;
+	}
+
+	/**
+	 *@brief Report that the out edges of <em>u</em> or their costs
+	 *       have changed
+	 *
+	 *@par Description:
+	 *  When an obstacle appears or disappears, call it for every key
+	 *  whose out edges are affected, e.g., for a grid cell and its
+	 *  neighbors.
+	 */
+	void NotifyOutEdgesChanged(const Key u);
+
+	/**
+	 *@brief Cost of the path from the start to the goal
+	 *
+	 *@par Description:
+	 *  The search can stop before the start itself is expanded, so the
+	 *  cost is given by its one-step lookahead (rhs) value.
+	 */
+	double GetPathCostFromStart(void) const
+	{
+	    const Data *data = m_map.GetDataPointer(m_start);
+	    return data ? data->m_rhs : HUGE_VAL;
+	}
+
+	/**
+	 *@brief Get the path from the start to the goal by following the
+	 *       out edges that minimize the cost-to-goal
+	 */
+	void GetPathFromStart(std::vector<Key> * const path) const;
+
+	/**
+	 *@brief Number of keys expanded since <em>Initialize</em>
+	 */
+	int GetNrExpansions(void) const
+	{
+	    return m_nrExpansions;
+	}
+
+    protected:
+	struct Data
+	{
+	    double m_g;
+	    double m_rhs;
+	    double m_k1;
+	    double m_k2;
+	};
+
+	/**
+	 *@brief Lexicographic order of the keys
+	 *
+	 *@par Description:
+	 *  The first components are sums of costs and heuristics computed
+	 *  along different paths, so they are compared up to round-off;
+	 *  otherwise, ties would not be broken by the second component and
+	 *  the search could stop too early.
+	 */
+	static bool KeyLess(const Data & du, const Data & dv)
+	{
+	    const double tol = Constants::EPSILON * (1 + fabs(du.m_k1));
+
+	    return du.m_k1 < dv.m_k1 - tol || (du.m_k1 <= dv.m_k1 + tol && du.m_k2 < dv.m_k2);
+	}
+
+	static bool LessFn(const Key u, const Key v, MapDefault<Key, Data> * const map)
+	{
+	    return KeyLess(map->GetData(u), map->GetData(v));
+	}
+
+	double GetGCost(const Key u) const
+	{
+	    const Data *data = m_map.GetDataPointer(u);
+	    return data ? data->m_g : HUGE_VAL;
+	}
+
+	Data* GetDataOrInsert(const Key u)
+	{
+	    Data *data = m_map.GetDataPointer(u);
+
+	    if(data == NULL)
+	    {
+		Data d;
+
+		d.m_g = d.m_rhs = d.m_k1 = d.m_k2 = HUGE_VAL;
+		m_map.Insert(u, d);
+		data = m_map.GetDataPointer(u);
+	    }
+	    return data;
+	}
+
+	void CalculateKey(const Key u, Data * const data) const
+	{
+	    const double m = data->m_g < data->m_rhs ? data->m_g : data->m_rhs;
+
+	    data->m_k1 = m + m_info->HeuristicCostFromStart(u) + m_km;
+	    data->m_k2 = m;
+	}
+
+	/**
+	 *@brief Set rhs to the best cost-to-goal through the out edges
+	 */
+	void ComputeRhs(const Key u);
+
+	void UpdateVertex(const Key u);
+
+	MapDefault<Key, Data>              m_map;
+	Heap<Key, MapDefault<Key, Data>* > m_heap;
+	Key                                m_start;
+	Key                                m_goal;
+	double                             m_km;
+	int                                m_nrExpansions;
+    };
+
+    template <typename Key>
+    void DStarLite<Key>::Initialize(const Key start, const Key goal)
+    {
+	m_map.Clear();
+	m_heap.Clear();
+	m_start        = start;
+	m_goal         = goal;
+	m_km           = 0;
+	m_nrExpansions = 0;
+
+	Data *data = GetDataOrInsert(goal);
+
+	data->m_rhs = 0;
+	CalculateKey(goal, data);
+	m_heap.Insert(goal);
+    }
+
+    template <typename Key>
+    void DStarLite<Key>::ComputeRhs(const Key u)
+    {
+	std::vector<Key>    edges;
+	std::vector<double> costs;
+	double              rhs = HUGE_VAL;
+
+	if(u == m_goal)
+	    return;
+
+	m_info->GetOutEdges(u, &edges, &costs);
+	for(int i = 0; i < (int) edges.size(); ++i)
+	{
+	    const double c = costs[i] + GetGCost(edges[i]);
+	    if(c < rhs)
+		rhs = c;
+	}
+	GetDataOrInsert(u)->m_rhs = rhs;
+    }
+
+    template <typename Key>
+    void DStarLite<Key>::UpdateVertex(const Key u)
+    {
+	Data       *data = GetDataOrInsert(u);
+	const bool  open = m_heap.HasKey(u);
+
+	if(data->m_g != data->m_rhs)
+	{
+	    CalculateKey(u, data);
+	    if(open)
+		m_heap.Update(u);
+	    else
+		m_heap.Insert(u);
+	}
+	else if(open)
+	    m_heap.Remove(u);
+    }
+
+    template <typename Key>
+    void DStarLite<Key>::NotifyOutEdgesChanged(const Key u)
+    {
+	ComputeRhs(u);
+	UpdateVertex(u);
+    }
+
+    template <typename Key>
+    bool DStarLite<Key>::ComputeShortestPath(void)
+    {
+	std::vector<Key>    edges;
+	std::vector<double> costs;
+
+	while(!m_heap.IsEmpty())
+	{
+	    const Key u     = m_heap.GetTop();
+	    Data     *data  = m_map.GetDataPointer(u);
+	    Data      start = {HUGE_VAL, HUGE_VAL, HUGE_VAL, HUGE_VAL};
+	    
+	    //the key of the start is not stored, since the start may be in the heap
+	    if(m_map.HasKey(m_start))
+		start = m_map.GetData(m_start);
+	    CalculateKey(m_start, &start);
+	    if(!KeyLess(*data, start) && start.m_rhs <= start.m_g)
+		break;
+
+	    const Data old = *data;
+
+	    CalculateKey(u, data);
+	    if(KeyLess(old, *data))
+	    {
+		//the key became stale after the start moved
+		m_heap.Update(u);
+		continue;
+	    }
+
+	    ++m_nrExpansions;
+	    edges.clear();
+	    costs.clear();
+	    m_info->GetInEdges(u, &edges, &costs);
+
+	    if(data->m_g > data->m_rhs)
+	    {
+		data->m_g = data->m_rhs;
+		m_heap.Remove(u);
+
+		const double gu = data->m_g;
+		for(int i = 0; i < (int) edges.size(); ++i)
+		    if(!(edges[i] == m_goal))
+		    {
+			Data *dv = GetDataOrInsert(edges[i]);
+			if(costs[i] + gu < dv->m_rhs)
+			{
+			    dv->m_rhs = costs[i] + gu;
+			    UpdateVertex(edges[i]);
+			}
+		    }
+	    }
+	    else
+	    {
+		const double gold = data->m_g;
+
+		data->m_g = HUGE_VAL;
+		for(int i = 0; i < (int) edges.size(); ++i)
+		    if(GetDataOrInsert(edges[i])->m_rhs <= costs[i] + gold + Constants::EPSILON * (1 + gold))
+		    {
+			ComputeRhs(edges[i]);
+			UpdateVertex(edges[i]);
+		    }
+		ComputeRhs(u);
+		UpdateVertex(u);
+	    }
+	}
+
+	return GetPathCostFromStart() != HUGE_VAL;
+    }
+
+    template <typename Key>
+    void DStarLite<Key>::GetPathFromStart(std::vector<Key> * const path) const
+    {
+	std::vector<Key>    edges;
+	std::vector<double> costs;
+	Key                 u = m_start;
+
+	if(GetPathCostFromStart() == HUGE_VAL)
+	    return;
+
+	path->push_back(u);
+	while(!(u == m_goal))
+	{
+	    double best = HUGE_VAL;
+	    Key    next = u;
+
+	    edges.clear();
+	    costs.clear();
+	    m_info->GetOutEdges(u, &edges, &costs);
+	    for(int i = 0; i < (int) edges.size(); ++i)
+	    {
+		const double c = costs[i] + GetGCost(edges[i]);
+		if(c < best)
+		{
+		    best = c;
+		    next = edges[i];
+		}
+	    }
+	    if(best == HUGE_VAL || (int) path->size() > m_map.GetNrKeys())
+		return;
+	    u = next;
+	    path->push_back(u);
+	}
+    }
+}
+
+#endif
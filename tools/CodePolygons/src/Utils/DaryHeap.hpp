@@ -0,0 +1,192 @@
+#ifndef ABETARE__DARY_HEAP_HPP_
+#define ABETARE__DARY_HEAP_HPP_
+
+#include <vector>
+
+namespace Abetare
+{
+    /**
+     *@brief Indexed d-ary min-heap over dense integer keys
+     *
+     *@par Description:
+     *  Unlike <em>Heap</em>, each entry stores its cost next to its
+     *  key, so comparisons do not go through a function pointer or a
+     *  map lookup. The position of each key in <em>[0, nrKeys)</em> is
+     *  kept in an array, which supports updating the cost of a key in
+     *  the heap. A 4-ary heap is shallower than a binary heap and the
+     *  children of a node share a cache line.
+     */
+    template <int Arity = 4>
+    class DaryHeap
+    {
+    public:
+	DaryHeap(void)
+	{
+	}
+
+	virtual ~DaryHeap(void)
+	{
+	}
+
+	/**
+	 *@brief Allocate the position array for keys in <em>[0, nrKeys)</em>
+	 */
+	void Setup(const int nrKeys)
+	{
+	    m_heap.clear();
+	    m_pos.assign(nrKeys, -1);
+	}
+
+	bool IsEmpty(void) const
+	{
+	    return m_heap.empty();
+	}
+
+	int GetNrKeys(void) const
+	{
+	    return m_heap.size();
+	}
+
+	bool HasKey(const int key) const
+	{
+	    return m_pos[key] >= 0;
+	}
+
+	double GetCost(const int key) const
+	{
+	    return m_heap[m_pos[key]].m_cost;
+	}
+
+	int GetTop(void) const
+	{
+	    return m_heap[0].m_key;
+	}
+
+	double GetTopCost(void) const
+	{
+	    return m_heap[0].m_cost;
+	}
+
+	void Insert(const int key, const double cost)
+	{
+	    m_heap.push_back(Entry());
+	    PrecolateUp(m_heap.size() - 1, key, cost);
+	}
+
+	/**
+	 *@brief Set the cost of a key that is in the heap
+	 */
+	void Update(const int key, const double cost)
+	{
+	    const int pos = m_pos[key];
+
+	    if(cost < m_heap[pos].m_cost)
+		PrecolateUp(pos, key, cost);
+	    else
+		PrecolateDown(pos, key, cost);
+	}
+
+	/**
+	 *@brief Insert the key or update its cost if it is in the heap
+	 */
+	void InsertOrUpdate(const int key, const double cost)
+	{
+	    if(HasKey(key))
+		Update(key, cost);
+	    else
+		Insert(key, cost);
+	}
+
+	int RemoveTop(void)
+	{
+	    const int key = m_heap[0].m_key;
+
+	    RemoveAtPosition(0);
+	    return key;
+	}
+
+	void Remove(const int key)
+	{
+	    RemoveAtPosition(m_pos[key]);
+	}
+
+	/**
+	 *@brief Empty the heap in time proportional to its size
+	 */
+	void Clear(void)
+	{
+	    const int n = m_heap.size();
+
+	    for(int i = 0; i < n; ++i)
+		m_pos[m_heap[i].m_key] = -1;
+	    m_heap.clear();
+	}
+
+    protected:
+	struct Entry
+	{
+	    double m_cost;
+	    int    m_key;
+	};
+
+	void RemoveAtPosition(const int pos)
+	{
+	    const Entry last = m_heap.back();
+
+	    m_pos[m_heap[pos].m_key] = -1;
+	    m_heap.pop_back();
+	    if(pos < (int) m_heap.size())
+	    {
+		if(pos > 0 && last.m_cost < m_heap[(pos - 1) / Arity].m_cost)
+		    PrecolateUp(pos, last.m_key, last.m_cost);
+		else
+		    PrecolateDown(pos, last.m_key, last.m_cost);
+	    }
+	}
+
+	void PrecolateUp(int pos, const int key, const double cost)
+	{
+	    while(pos > 0)
+	    {
+		const int parent = (pos - 1) / Arity;
+
+		if(!(cost < m_heap[parent].m_cost))
+		    break;
+		m_heap[pos] = m_heap[parent];
+		m_pos[m_heap[pos].m_key] = pos;
+		pos = parent;
+	    }
+	    m_heap[pos].m_key  = key;
+	    m_heap[pos].m_cost = cost;
+	    m_pos[key]         = pos;
+	}
+
+	void PrecolateDown(int pos, const int key, const double cost)
+	{
+	    const int size = m_heap.size();
+
+	    for(int first = Arity * pos + 1; first < size; first = Arity * pos + 1)
+	    {
+		const int last  = first + Arity < size ? first + Arity : size;
+		int       child = first;
+
+		for(int i = first + 1; i < last; ++i)
+		    if(m_heap[i].m_cost < m_heap[child].m_cost)
+			child = i;
+		if(!(m_heap[child].m_cost < cost))
+		    break;
+		m_heap[pos] = m_heap[child];
+		m_pos[m_heap[pos].m_key] = pos;
+		pos = child;
+	    }
+	    m_heap[pos].m_key  = key;
+	    m_heap[pos].m_cost = cost;
+	    m_pos[key]         = pos;
+	}
+
+	std::vector<Entry> m_heap;
+	std::vector<int>   m_pos;
+    };
+}
+
+#endif
@@ -0,0 +1,193 @@
+#include "Utils/DeltaStepping.hpp"
+#include "Utils/Parallel.hpp"
+
+namespace Abetare
+{
+    //frontiers smaller than this are not worth waking up the threads
+    static const int DELTA_STEPPING_MIN_PARALLEL = 256;
+
+    unsigned int DeltaStepping::NewStamp(void)
+    {
+	if(++m_stamp == 0)
+	{
+	    m_frontierStamps.assign(m_frontierStamps.size(), 0);
+	    m_settledStamps.assign(m_settledStamps.size(), 0);
+	    m_stamp = 1;
+	}
+	return m_stamp;
+    }
+
+    void DeltaStepping::AddToBucket(const int u, const double delta)
+    {
+	const int b = (int) (m_costs[u].load(std::memory_order_relaxed) / delta);
+
+	if(b >= (int) m_buckets.size())
+	    m_buckets.resize(b + 1);
+	m_buckets[b].push_back(u);
+    }
+
+    void DeltaStepping::Relax(const bool light, const double delta, const int nrThreads)
+    {
+	const int     n       = m_frontier.size();
+	const int    *targets = m_graph->GetEdgeTargets();
+	const double *ecosts  = m_graph->GetEdgeCosts();
+
+	ParallelFor(n, n < DELTA_STEPPING_MIN_PARALLEL ? 1 : nrThreads, [&](const int i, const int t)
+		    {
+			const int    u   = m_frontier[i];
+			const double du  = m_costs[u].load(std::memory_order_relaxed);
+			const int    end = m_graph->GetEndEdge(u);
+
+			for(int e = m_graph->GetFirstEdge(u); e < end; ++e)
+			    if((ecosts[e] <= delta) == light)
+			    {
+				const int    v   = targets[e];
+				const double dv  = du + ecosts[e];
+				double       old = m_costs[v].load(std::memory_order_relaxed);
+
+				while(dv < old)
+				    if(m_costs[v].compare_exchange_weak(old, dv, std::memory_order_relaxed))
+				    {
+					m_buffers[t].push_back(v);
+					break;
+				    }
+			    }
+		    }, 64);
+
+	for(int t = 0; t < (int) m_buffers.size(); ++t)
+	{
+	    for(int i = 0; i < (int) m_buffers[t].size(); ++i)
+		AddToBucket(m_buffers[t][i], delta);
+	    m_buffers[t].clear();
+	}
+    }
+
+    void DeltaStepping::Run(const int start)
+    {
+	const int n         = m_graph->GetNrVertices();
+	const int nrThreads = m_nrThreads > 0 ? m_nrThreads : GetNrHardwareThreads();
+	double    delta     = m_delta;
+
+	if(delta <= 0)
+	{
+	    const int ne = m_graph->GetNrEdges();
+
+	    delta = 0;
+	    for(int e = 0; e < ne; ++e)
+		delta += m_graph->GetEdgeCost(e);
+	    delta = ne > 0 && delta > 0 ? delta / ne : 1;
+	}
+
+	if((int) m_costs.size() != n)
+	{
+	    std::vector<std::atomic<double> > costs(n);
+	    std::vector<std::atomic<int> >    minParents(n);
+
+	    m_costs.swap(costs);
+	    m_minParents.swap(minParents);
+	    m_frontierStamps.assign(n, 0);
+	    m_settledStamps.assign(n, 0);
+	    m_stamp = 0;
+	}
+	for(int u = 0; u < n; ++u)
+	{
+	    m_costs[u].store(HUGE_VAL, std::memory_order_relaxed);
+	    m_minParents[u].store(n, std::memory_order_relaxed);
+	}
+	m_buffers.resize(nrThreads);
+	m_buckets.clear();
+
+	m_costs[start].store(0, std::memory_order_relaxed);
+	AddToBucket(start, delta);
+
+	for(int b = 0; b < (int) m_buckets.size(); ++b)
+	{
+	    const unsigned int settled = NewStamp();
+
+	    m_settled.clear();
+	    while(!m_buckets[b].empty())
+	    {
+		const unsigned int frontier = NewStamp();
+		std::vector<int>   bucket;
+
+		//entries are stale if the vertex has moved to another bucket or is repeated
+		bucket.swap(m_buckets[b]);
+		m_frontier.clear();
+		for(int i = 0; i < (int) bucket.size(); ++i)
+		{
+		    const int u = bucket[i];
+
+		    if((int) (m_costs[u].load(std::memory_order_relaxed) / delta) != b ||
+		       m_frontierStamps[u] == frontier)
+			continue;
+		    m_frontierStamps[u] = frontier;
+		    m_frontier.push_back(u);
+		    if(m_settledStamps[u] != settled)
+		    {
+			m_settledStamps[u] = settled;
+			m_settled.push_back(u);
+		    }
+		}
+		Relax(true, delta, nrThreads);
+	    }
+
+	    //heavy edges lead to later buckets, so they are relaxed once
+	    m_frontier.swap(m_settled);
+	    Relax(false, delta, nrThreads);
+	}
+
+	m_gCosts.resize(n);
+	for(int u = 0; u < n; ++u)
+	    m_gCosts[u] = m_costs[u].load(std::memory_order_relaxed);
+
+	//the parent is the lowest vertex id through which the cost is attained
+	const int    *targets = m_graph->GetEdgeTargets();
+	const double *ecosts  = m_graph->GetEdgeCosts();
+
+	ParallelFor(n, nrThreads, [&](const int u, const int t)
+		    {
+			const double du  = m_gCosts[u];
+			const int    end = m_graph->GetEndEdge(u);
+
+			if(du == HUGE_VAL)
+			    return;
+			for(int e = m_graph->GetFirstEdge(u); e < end; ++e)
+			{
+			    const int v = targets[e];
+
+			    if(v != start && du + ecosts[e] == m_gCosts[v])
+			    {
+				int old = m_minParents[v].load(std::memory_order_relaxed);
+
+				while(u < old && !m_minParents[v].compare_exchange_weak(old, u, std::memory_order_relaxed))
+				    ;
+			    }
+			}
+		    }, 1024);
+
+	m_parents.resize(n);
+	for(int u = 0; u < n; ++u)
+	{
+	    const int p = m_minParents[u].load(std::memory_order_relaxed);
+
+	    m_parents[u] = p == n ? Constants::ID_UNDEFINED : p;
+	}
+	m_parents[start] = start;
+    }
+
+    void DeltaStepping::GetReversePathFromStart(const int u, std::vector<int> * const rpath) const
+    {
+	if(!IsVisited(u))
+	    return;
+
+	int p = u, v;
+
+	do
+	{
+	    v = p;
+	    rpath->push_back(v);
+	    p = m_parents[v];
+	}
+	while(v != p);
+    }
+}
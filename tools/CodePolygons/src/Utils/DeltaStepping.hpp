@@ -0,0 +1,111 @@
+#ifndef ABETARE__DELTA_STEPPING_HPP_
+#define ABETARE__DELTA_STEPPING_HPP_
+
+#include "Utils/CSRGraph.hpp"
+#include "Utils/Misc.hpp"
+#include "Utils/Constants.hpp"
+#include <vector>
+#include <atomic>
+#include <cmath>
+
+namespace Abetare
+{
+    /**
+     *@brief Multithreaded single-source shortest paths by delta-stepping
+     *
+     *@par Description:
+     *  Vertices are kept in buckets of width <em>m_delta</em> by their
+     *  tentative cost. The vertices of the lowest nonempty bucket are
+     *  settled together: their light edges (cost at most
+     *  <em>m_delta</em>) are relaxed in parallel until the bucket stays
+     *  empty, and then their heavy edges once. Costs are lowered with
+     *  atomic compare-and-swap. Once all costs are final, the parent of
+     *  each vertex is set to the lowest vertex id through which its cost
+     *  is attained, so results do not depend on the thread schedule.
+     *  \n\n
+     *  Costs equal those of Dijkstra and A*, while parents may differ
+     *  between equally short paths. Edge costs must be positive.
+     */
+    class DeltaStepping
+    {
+    public:
+	DeltaStepping(void)
+	{
+	    m_graph     = NULL;
+	    m_delta     = 0;
+	    m_nrThreads = 0;
+	    m_stamp     = 0;
+	}
+
+	virtual ~DeltaStepping(void)
+	{
+	}
+
+	const CSRGraph *m_graph;
+
+	/**
+	 *@brief Bucket width; when not positive, the average edge cost
+	 *       is used
+	 */
+	double m_delta;
+
+	/**
+	 *@brief Number of threads; when not positive, the number of
+	 *       hardware threads is used
+	 */
+	int m_nrThreads;
+
+	/**
+	 *@brief Compute the costs from <em>start</em> to all vertices
+	 */
+	void Run(const int start);
+
+	bool IsVisited(const int u) const
+	{
+	    return m_parents[u] != Constants::ID_UNDEFINED;
+	}
+
+	int GetParent(const int u) const
+	{
+	    return m_parents[u];
+	}
+
+	void GetReversePathFromStart(const int u, std::vector<int> * const rpath) const;
+
+	void GetPathFromStart(const int u, std::vector<int> * const path) const
+	{
+	    GetReversePathFromStart(u, path);
+	    ReverseItems<int>(path);
+	}
+
+	double GetPathCostFromStart(const int u) const
+	{
+	    return m_gCosts[u];
+	}
+
+    protected:
+	/**
+	 *@brief Relax the light or heavy edges of the vertices in
+	 *       <em>m_frontier</em> and bucket the improved vertices
+	 */
+	void Relax(const bool light, const double delta, const int nrThreads);
+
+	void AddToBucket(const int u, const double delta);
+
+	unsigned int NewStamp(void);
+
+	std::vector<double>               m_gCosts;
+	std::vector<int>                  m_parents;
+	std::vector<std::atomic<double> > m_costs;
+	std::vector<std::atomic<int> >    m_minParents;
+	std::vector<std::vector<int> >    m_buckets;
+	std::vector<std::vector<int> >    m_buffers;
+	std::vector<int>                  m_frontier;
+	std::vector<int>                  m_settled;
+	std::vector<unsigned int>         m_frontierStamps;
+	std::vector<unsigned int>         m_settledStamps;
+	unsigned int                      m_stamp;
+    };
+}
+
+#endif
@@ -0,0 +1,228 @@
+#include "Utils/DenseGraphSearch.hpp"
+
+namespace Abetare
+{
+    void DenseGraphSearch::Setup(const int nrKeys)
+    {
+	m_parents.resize(nrKeys);
+	m_gCosts.resize(nrKeys);
+	m_hCosts.resize(nrKeys);
+	m_stamps.assign(nrKeys, 0);
+	m_stamp = 0;
+	m_heap.Setup(nrKeys);
+    }
+
+    void DenseGraphSearch::NewSearch(void)
+    {
+	m_heap.Clear();
+	m_nrExpansions = 0;
+	if(++m_stamp == 0)
+	{
+	    //stamp wrapped around: invalidate all keys explicitly
+	    m_stamps.assign(m_stamps.size(), 0);
+	    m_stamp = 1;
+	}
+    }
+
+    void DenseGraphSearch::GetReversePathFromStart(const int u, std::vector<int> * const rpath) const
+    {
+	if(u < 0 || u >= GetNrKeys() || !IsVisited(u))
+	    return;
+
+	int p = u, v;
+
+	do
+	{
+	    v = p;
+	    rpath->push_back(v);
+	    p = m_parents[v];
+	}
+	while(v != p);
+    }
+
+    int DenseGraphSearch::GetPathLengthFromStart(const int u) const
+    {
+	if(u < 0 || u >= GetNrKeys() || !IsVisited(u))
+	    return -1;
+
+	int p = u, v;
+	int count = 0;
+
+	do
+	{
+	    v = p;
+	    ++count;
+	    p = m_parents[v];
+	}
+	while(v != p);
+
+	return count;
+    }
+
+    bool DenseGraphSearch::BFS(const int start, int * const goal)
+    {
+	NewSearch();
+	Visit(start, start, 0, 0);
+	if(m_info->IsGoal(start))
+	{
+	    *goal = start;
+	    return true;
+	}
+
+	m_queue.clear();
+	m_queue.push_back(start);
+	for(int front = 0; front < (int) m_queue.size(); ++front)
+	{
+	    const int u = m_queue[front];
+
+	    ++m_nrExpansions;
+	    m_edges.clear();
+	    m_info->GetOutEdges(u, &m_edges);
+
+	    const int n = m_edges.size();
+	    for(int i = 0; i < n; ++i)
+	    {
+		const int v = m_edges[i];
+
+		if(!IsVisited(v))
+		{
+		    Visit(v, u, m_gCosts[u] + 1, 0);
+		    if(m_info->IsGoal(v))
+		    {
+			*goal = v;
+			return true;
+		    }
+		    m_queue.push_back(v);
+		}
+	    }
+	}
+
+	return false;
+    }
+
+    /**
+     *@brief Edges, goal test and heuristic of a <em>GraphSearchInfo</em>,
+     *       whose out edges are copied to the buffers of the search
+     */
+    struct DenseGraphSearchInfoPolicy
+    {
+	const GraphSearchInfo<int> *m_info;
+	std::vector<int>           *m_edges;
+	std::vector<double>        *m_costs;
+
+	bool IsGoal(const int u) const
+	{
+	    return m_info->IsGoal(u);
+	}
+
+	double HeuristicCostToGoal(const int u) const
+	{
+	    return m_info->HeuristicCostToGoal(u);
+	}
+
+	int GetOutEdges(const int u, const int ** const targets, const double ** const costs) const
+	{
+	    m_edges->clear();
+	    m_costs->clear();
+	    m_info->GetOutEdges(u, m_edges, m_costs);
+	    *targets = m_edges->data();
+	    *costs   = m_costs->data();
+	    return m_edges->size();
+	}
+    };
+
+    /**
+     *@brief Edges read in place from a <em>CSRSearchInfo</em>, with
+     *       non-virtual calls to its goal test and heuristic
+     */
+    struct DenseGraphSearchCSRPolicy
+    {
+	const CSRSearchInfo *m_info;
+
+	bool IsGoal(const int u) const
+	{
+	    return m_info->CSRSearchInfo::IsGoal(u);
+	}
+
+	double HeuristicCostToGoal(const int u) const
+	{
+	    return m_info->CSRSearchInfo::HeuristicCostToGoal(u);
+	}
+
+	int GetOutEdges(const int u, const int ** const targets, const double ** const costs) const
+	{
+	    return m_info->GetOutEdgeSpan(u, targets, costs);
+	}
+    };
+
+    template <typename Policy>
+    bool DenseGraphSearch::AStar(const Policy & policy, const int start, const bool breakEarly, int * const goal)
+    {
+	NewSearch();
+	Visit(start, start, 0, policy.HeuristicCostToGoal(start));
+	m_heap.Insert(start, m_hCosts[start]);
+
+	while(!m_heap.IsEmpty())
+	{
+	    const int u = m_heap.RemoveTop();
+
+	    ++m_nrExpansions;
+	    if(policy.IsGoal(u))
+	    {
+		*goal = u;
+		return true;
+	    }
+
+	    const int    *targets;
+	    const double *costs;
+	    const int     n  = policy.GetOutEdges(u, &targets, &costs);
+	    const double  gu = m_gCosts[u];
+
+	    for(int i = 0; i < n; ++i)
+	    {
+		const int    v  = targets[i];
+		const double gv = gu + costs[i];
+
+		if(!IsVisited(v))
+		{
+		    Visit(v, u, gv, policy.HeuristicCostToGoal(v));
+		    m_heap.Insert(v, gv + m_hCosts[v]);
+
+		    if(breakEarly && policy.IsGoal(v))
+		    {
+			*goal = v;
+			return true;
+		    }
+		}
+		else if(gv < m_gCosts[v])
+		{
+		    m_parents[v] = u;
+		    m_gCosts[v]  = gv;
+		    m_heap.InsertOrUpdate(v, gv + m_hCosts[v]); //reopens when the heuristic is inconsistent
+		}
+	    }
+	}
+
+	return false;
+    }
+
+    bool DenseGraphSearch::AStar(const int start, const bool breakEarly, int * const goal)
+    {
+	DenseGraphSearchInfoPolicy policy;
+
+	policy.m_info  = m_info;
+	policy.m_edges = &m_edges;
+	policy.m_costs = &m_costs;
+
+	return AStar(policy, start, breakEarly, goal);
+    }
+
+    bool DenseGraphSearch::AStar(const CSRSearchInfo & info, const int start, const bool breakEarly, int * const goal)
+    {
+	DenseGraphSearchCSRPolicy policy;
+
+	policy.m_info = &info;
+
+	return AStar(policy, start, breakEarly, goal);
+    }
+}
@@ -0,0 +1,129 @@
+#ifndef ABETARE__DENSE_GRAPH_SEARCH_HPP_
+#define ABETARE__DENSE_GRAPH_SEARCH_HPP_
+
+#include "Utils/GraphSearch.hpp"
+#include "Utils/CSRSearchInfo.hpp"
+#include "Utils/DaryHeap.hpp"
+#include <vector>
+#include <cmath>
+
+namespace Abetare
+{
+    /**
+     *@brief Graph search over dense integer keys in <em>[0, nrKeys)</em>
+     *
+     *@par Description:
+     *  Breadth-first search and A* as in <em>GraphSearch<int></em>,
+     *  e.g., over grid cell ids or roadmap vertex ids, but parent,
+     *  g-cost and h-cost are kept in flat arrays indexed by the key and
+     *  the open list is a 4-ary <em>DaryHeap</em> that stores the
+     *  f-costs inline. DFS, randomized BFS, bidirectional and anytime
+     *  A* are only in <em>GraphSearch</em>.
+     *  A key is valid for the current search only if its visit stamp
+     *  matches, so starting a new search does not touch the arrays.
+     */
+    class DenseGraphSearch
+    {
+    public:
+	DenseGraphSearch(void)
+	{
+	    m_info         = NULL;
+	    m_stamp        = 0;
+	    m_nrExpansions = 0;
+	}
+
+	virtual ~DenseGraphSearch(void)
+	{
+	}
+
+	GraphSearchInfo<int> *m_info;
+
+	/**
+	 *@brief Allocate the arrays for keys in <em>[0, nrKeys)</em>
+	 */
+	virtual void Setup(const int nrKeys);
+
+	int GetNrKeys(void) const
+	{
+	    return m_parents.size();
+	}
+
+	bool BFS(const int start, int * const goal);
+
+	bool AStar(const int start, const bool breakEarly, int * const goal);
+
+	/**
+	 *@brief Same as <em>AStar</em> but over the graph of <em>info</em>,
+	 *       which is used instead of <em>m_info</em>
+	 *
+	 *@par Description:
+	 *  Edges are read in place from the graph arrays and the goal test
+	 *  and heuristic are called on <em>CSRSearchInfo</em> directly, so
+	 *  the expansion loop has no virtual calls and no copies. Overrides
+	 *  of these members in derived classes are not used.
+	 */
+	bool AStar(const CSRSearchInfo & info, const int start, const bool breakEarly, int * const goal);
+
+	/**
+	 *@brief Returns true if the key was reached by the last search
+	 */
+	bool IsVisited(const int u) const
+	{
+	    return m_stamps[u] == m_stamp;
+	}
+
+	void GetReversePathFromStart(const int u, std::vector<int> * const rpath) const;
+
+	void GetPathFromStart(const int u, std::vector<int> * const path) const
+	{
+	    GetReversePathFromStart(u, path);
+	    ReverseItems<int>(path);
+	}
+
+	int GetPathLengthFromStart(const int u) const;
+
+	double GetPathCostFromStart(const int u) const
+	{
+	    return IsVisited(u) ? m_gCosts[u] : HUGE_VAL;
+	}
+
+	/**
+	 *@brief Number of keys expanded by the last search
+	 */
+	int GetNrExpansions(void) const
+	{
+	    return m_nrExpansions;
+	}
+
+    protected:
+	void NewSearch(void);
+
+	/**
+	 *@brief A* loop shared by both overloads, with the edges, goal
+	 *       test and heuristic taken from <em>policy</em>
+	 */
+	template <typename Policy>
+	bool AStar(const Policy & policy, const int start, const bool breakEarly, int * const goal);
+
+	void Visit(const int u, const int parent, const double gCost, const double hCost)
+	{
+	    m_stamps[u]  = m_stamp;
+	    m_parents[u] = parent;
+	    m_gCosts[u]  = gCost;
+	    m_hCosts[u]  = hCost;
+	}
+
+	std::vector<int>          m_parents;
+	std::vector<double>       m_gCosts;
+	std::vector<double>       m_hCosts;
+	std::vector<unsigned int> m_stamps;
+	DaryHeap<4>               m_heap;
+	std::vector<int>          m_queue;
+	unsigned int              m_stamp;
+	std::vector<int>          m_edges;
+	std::vector<double>       m_costs;
+	int                       m_nrExpansions;
+    };
+}
+
+#endif
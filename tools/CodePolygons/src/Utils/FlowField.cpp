@@ -0,0 +1,104 @@
+#include "Utils/FlowField.hpp"
+
+namespace Abetare
+{
+    void FlowField::Setup(const int nrKeys)
+    {
+	m_costs.assign(nrKeys, HUGE_VAL);
+	m_next.assign(nrKeys, Constants::ID_UNDEFINED);
+	m_dirs.clear();
+	m_heap.Setup(nrKeys);
+	m_goal = Constants::ID_UNDEFINED;
+    }
+
+    void FlowField::Compute(const int goal)
+    {
+	m_costs.assign(m_costs.size(), HUGE_VAL);
+	m_next.assign(m_next.size(), Constants::ID_UNDEFINED);
+	m_heap.Clear();
+	m_goal = goal;
+
+	m_costs[goal] = 0;
+	m_next[goal]  = goal;
+	m_heap.Insert(goal, 0);
+
+	while(!m_heap.IsEmpty())
+	{
+	    const int    v  = m_heap.RemoveTop();
+	    const double cv = m_costs[v];
+
+	    //edges (u, v) lead from the keys u into v
+	    m_edges.clear();
+	    m_ecosts.clear();
+	    m_info->GetInEdges(v, &m_edges, &m_ecosts);
+
+	    const int n = m_edges.size();
+	    for(int i = 0; i < n; ++i)
+	    {
+		const int    u  = m_edges[i];
+		const double cu = cv + m_ecosts[i];
+
+		if(cu < m_costs[u])
+		{
+		    m_costs[u] = cu;
+		    m_next[u]  = v;
+		    m_heap.InsertOrUpdate(u, cu);
+		}
+	    }
+	}
+    }
+
+    void FlowField::GetPathToGoal(const int u, std::vector<int> * const path) const
+    {
+	if(!CanReachGoal(u))
+	    return;
+
+	int v = u;
+
+	path->push_back(v);
+	while(v != m_goal)
+	{
+	    v = m_next[v];
+	    path->push_back(v);
+	}
+    }
+
+    void FlowField::ComputeDirections(const Grid * const grid)
+    {
+	const int n = GetNrKeys();
+	double    c[2], cnext[2];
+
+	m_grid = grid;
+	m_dirs.assign(2 * n, 0.0);
+	for(int u = 0; u < n; ++u)
+	{
+	    const int v = m_next[u];
+
+	    if(v == Constants::ID_UNDEFINED || v == u)
+		continue;
+
+	    grid->GetCellCenterFromId(u, c);
+	    grid->GetCellCenterFromId(v, cnext);
+
+	    const double dx = cnext[0] - c[0];
+	    const double dy = cnext[1] - c[1];
+	    const double d  = sqrt(dx * dx + dy * dy);
+
+	    m_dirs[2 * u]     = dx / d;
+	    m_dirs[2 * u + 1] = dy / d;
+	}
+    }
+
+    bool FlowField::GetDirection(const double p[], double dir[]) const
+    {
+	const int u = m_grid->GetCellIdIfInside(p);
+
+	if(u == Constants::ID_UNDEFINED || !CanReachGoal(u))
+	    return false;
+
+	dir[0] = m_dirs[2 * u];
+	dir[1] = m_dirs[2 * u + 1];
+
+	return true;
+    }
+}
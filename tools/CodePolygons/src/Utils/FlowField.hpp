@@ -0,0 +1,128 @@
+#ifndef ABETARE__FLOW_FIELD_HPP_
+#define ABETARE__FLOW_FIELD_HPP_
+
+#include "Utils/GraphSearch.hpp"
+#include "Utils/DaryHeap.hpp"
+#include "Utils/Grid.hpp"
+#include "Utils/Constants.hpp"
+#include <vector>
+#include <cmath>
+
+namespace Abetare
+{
+    /**
+     *@brief Cost-to-go field from a single goal over dense integer keys
+     *
+     *@par Description:
+     *  Runs Dijkstra backward from the goal, following
+     *  <em>GetInEdges</em>, and stores for each key its cost to the goal
+     *  and the next key along a shortest path. Keys can be grid cell ids
+     *  or roadmap vertex ids. All agents heading to the same goal then
+     *  read their next step, or their heading when the keys are grid
+     *  cells, in constant time instead of each running its own search.
+     */
+    class FlowField
+    {
+    public:
+	FlowField(void)
+	{
+	    m_info = NULL;
+	    m_grid = NULL;
+	    m_goal = Constants::ID_UNDEFINED;
+	}
+
+	virtual ~FlowField(void)
+	{
+	}
+
+	GraphSearchInfo<int> *m_info;
+
+	/**
+	 *@brief Allocate the field for keys in <em>[0, nrKeys)</em>
+	 */
+	virtual void Setup(const int nrKeys);
+
+	int GetNrKeys(void) const
+	{
+	    return m_costs.size();
+	}
+
+	int GetGoal(void) const
+	{
+	    return m_goal;
+	}
+
+	/**
+	 *@brief Compute the cost to <em>goal</em> from every key
+	 */
+	void Compute(const int goal);
+
+	/**
+	 *@brief Returns true if the goal can be reached from <em>u</em>
+	 */
+	bool CanReachGoal(const int u) const
+	{
+	    return m_next[u] != Constants::ID_UNDEFINED;
+	}
+
+	double GetCostToGoal(const int u) const
+	{
+	    return m_costs[u];
+	}
+
+	/**
+	 *@brief Next key along a shortest path from <em>u</em> to the goal
+	 *
+	 *@par Description:
+	 *  The goal is its own next key. Returns
+	 *  <em>Constants::ID_UNDEFINED</em> if the goal cannot be reached.
+	 */
+	int GetNext(const int u) const
+	{
+	    return m_next[u];
+	}
+
+	void GetPathToGoal(const int u, std::vector<int> * const path) const;
+
+	/**
+	 *@brief Compute the heading of each cell when the keys are the
+	 *       cell ids of <em>grid</em>
+	 *
+	 *@par Description:
+	 *  The heading is the unit vector from the cell center to the
+	 *  center of its next cell. It is zero at the goal and at cells
+	 *  that cannot reach the goal. Call after <em>Compute</em>.
+	 */
+	void ComputeDirections(const Grid * const grid);
+
+	/**
+	 *@brief Heading of cell <em>u</em>, as computed by
+	 *       <em>ComputeDirections</em>
+	 */
+	const double* GetDirection(const int u) const
+	{
+	    return &(m_dirs[2 * u]);
+	}
+
+	/**
+	 *@brief Heading at point <em>p</em>, i.e., the heading of the
+	 *       cell that contains it
+	 *
+	 *@returns false if <em>p</em> is outside the grid or cannot
+	 *         reach the goal
+	 */
+	bool GetDirection(const double p[], double dir[]) const;
+
+    protected:
+	std::vector<double> m_costs;
+	std::vector<int>    m_next;
+	std::vector<double> m_dirs;
+	DaryHeap<4>         m_heap;
+	const Grid         *m_grid;
+	int                 m_goal;
+	std::vector<int>    m_edges;
+	std::vector<double> m_ecosts;
+    };
+}
+
+#endif
@@ -5,6 +5,8 @@
 #include "Utils/Map.hpp"
 #include "Utils/Heap.hpp"
 #include "Utils/Misc.hpp"
+#include "Utils/Timer.hpp"
+#include "Utils/GraphSearchStats.hpp"
 #include <stack>
 #include <queue>
 #include <cstdio>
@@ -26,6 +28,20 @@ namespace Abetare
 	virtual void GetOutEdges(const Key u, 
 				 std::vector<Key> * const edges,
 				 std::vector<double> * const costs = NULL) const = 0;
+
+	/**
+	 *@brief Get the keys <em>u</em> with an edge <em>(u, v)</em>,
+	 *       used by searches that run backward from the goal
+	 *
+	 *@par Description:
+	 *  Defaults to the out edges, which is correct for undirected graphs.
+	 */
+	virtual void GetInEdges(const Key v, 
+				std::vector<Key> * const edges,
+				std::vector<double> * const costs = NULL) const
+	{
+	    GetOutEdges(v, edges, costs);
+	}
 	
 	virtual bool IsGoal(const Key key) const = 0;	
 
@@ -34,6 +50,15 @@ namespace Abetare
 	    return 0;
 	}
 
+	/**
+	 *@brief Heuristic cost from the start to <em>u</em>, used by
+	 *       searches that run backward from the goal
+	 */
+	virtual double HeuristicCostFromStart(const Key u) const
+	{
+	    return 0;
+	}
+
 	virtual void PrintKey(const Key u) const
 	{
 	}
@@ -47,9 +72,16 @@ namespace Abetare
     public:
 	GraphSearch(void)
 	{
-	    m_heap.m_lessFn     = LessFn;
-	    m_heap.m_lessFnData = &m_map;
-	    m_info              = NULL;
+	    m_heap.m_lessFn             = LessFn;
+	    m_heap.m_lessFnData         = &m_map;
+	    m_heapBackward.m_lessFn     = LessFn;
+	    m_heapBackward.m_lessFnData = &m_mapBackward;
+	    m_goalHeap.m_lessFn         = LessFn;
+	    m_goalHeap.m_lessFnData     = &m_goalMap;
+	    m_info                      = NULL;
+	    m_stats                     = NULL;
+	    m_trace                     = NULL;
+	    m_nrExpansions              = 0;
 	}
 	
 	virtual ~GraphSearch(void)
@@ -58,11 +90,117 @@ namespace Abetare
 	
 	GraphSearchInfo<Key> *m_info;
 
+	/**
+	 *@brief When not NULL, filled by <em>AStar</em>,
+	 *       <em>BidirectionalAStar</em>, <em>AnytimeAStar</em> and
+	 *       <em>SearchBackwardFromGoal</em>
+	 */
+	GraphSearchStats *m_stats;
+
+	/**
+	 *@brief When not NULL, records the expansions of the same searches
+	 */
+	GraphSearchTrace<Key> *m_trace;
+
 	bool DFS(const Key start, const bool randomize, Key * const goal);
 	
 	bool BFS(const Key start, const bool randomize, Key * const goal);
 	
 	bool AStar(const Key start, const bool breakEarly, Key * const goal);
+
+	/**
+	 *@brief A* from both <em>start</em> and <em>goal</em>
+	 *
+	 *@par Description:
+	 *  The backward search follows <em>GetInEdges</em>. Both searches
+	 *  are guided by the average potential
+	 *  <em>p(u) = (HeuristicCostToGoal(u) - HeuristicCostFromStart(u)) / 2</em>,
+	 *  with <em>p</em> forward and <em>-p</em> backward, so that they
+	 *  work on the same reduced edge costs. With consistent heuristics,
+	 *  the best path found through a key reached by both sides is then
+	 *  optimal once the sum of the two minimum keys reaches its cost.
+	 *  Each iteration expands the side with fewer open keys. On
+	 *  success, the backward part of the path is spliced into the
+	 *  forward search tree, so <em>GetPathFromStart(goal)</em> and
+	 *  <em>GetPathCostFromStart(goal)</em> work as after <em>AStar</em>.
+	 */
+	bool BidirectionalAStar(const Key start, const Key goal);
+
+	/**
+	 *@brief Anytime repairing A* (ARA*) within a wall-clock budget
+	 *
+	 *@par Description:
+	 *  Keys are ordered by <em>g + epsilon * h</em>. A first path is
+	 *  found quickly with the inflated weight <em>epsilon</em>, which
+	 *  is then lowered by <em>decrease</em> after each improvement, down
+	 *  to 1. Each improvement reuses the search tree: only keys whose
+	 *  cost dropped after they were expanded are expanded again. The
+	 *  search stops when the path is optimal or after <em>budget</em>
+	 *  seconds, measured with <em>Timer</em>, and the best path found
+	 *  so far is kept, as after <em>AStar</em>. The budget is checked
+	 *  every 32 expansions and while the keys are reweighted, and the
+	 *  lower bound on the optimal cost is kept up to date as keys are
+	 *  opened, so no step between checks depends on the size of the
+	 *  open list.
+	 *
+	 *@param bound set to the suboptimality bound of the path, i.e., its
+	 *       cost is at most <em>bound</em> times the optimal cost
+	 *@returns false if no path was found within the budget
+	 */
+	bool AnytimeAStar(const Key start, const double epsilon, const double decrease,
+			  const double budget, Key * const goal, double * const bound);
+
+	/**
+	 *@brief Dijkstra backward from <em>goal</em>, whose tree is kept
+	 *       for the queries of <em>GetPathToGoal</em>
+	 *
+	 *@par Description:
+	 *  The search follows <em>GetInEdges</em> and settles the keys whose
+	 *  cost to <em>goal</em> is at most <em>maxCost</em>, or all the
+	 *  keys that reach <em>goal</em> when <em>maxCost</em> is
+	 *  <em>HUGE_VAL</em>. The tree is independent of the forward
+	 *  searches, so it stays valid until the next call, as long as the
+	 *  graph does not change.
+	 */
+	void SearchBackwardFromGoal(const Key goal, const double maxCost = HUGE_VAL);
+
+	/**
+	 *@brief Returns true if the goal tree gives the shortest path from
+	 *       <em>start</em>
+	 */
+	bool IsInGoalTree(const Key start) const
+	{
+	    return m_goalMap.HasKey(start) && !m_goalHeap.HasKey(start);
+	}
+
+	double GetPathCostToGoal(const Key start) const
+	{
+	    return IsInGoalTree(start) ? m_goalMap.GetData(start).m_gCost : HUGE_VAL;
+	}
+
+	/**
+	 *@brief Add the path from <em>start</em> to the goal of
+	 *       <em>SearchBackwardFromGoal</em> to <em>path</em>
+	 *
+	 *@par Description:
+	 *  For keys settled by the backward search, the path is read from
+	 *  the tree in time linear in its length, so many agents with the
+	 *  same goal share one search. For other keys, <em>AStar</em> runs
+	 *  from <em>start</em>, which expects <em>m_info</em> to have the
+	 *  same goal, and its path is used.
+	 *
+	 *@returns false if there is no path
+	 */
+	bool GetPathToGoal(const Key start, std::vector<Key> * const path);
+
+	/**
+	 *@brief Number of keys expanded by the last <em>AStar</em> or
+	 *       <em>BidirectionalAStar</em>
+	 */
+	int GetNrExpansions(void) const
+	{
+	    return m_nrExpansions;
+	}
 	
 	void GetReversePathFromStart(const Key u, std::vector<Key> * const rpath) const
 	{
@@ -123,9 +261,106 @@ namespace Abetare
 
 	static bool LessFn(const Key u, const Key v, MapDefault<Key, Data> * const map);
 
+	/**
+	 *@brief Unweighted f-cost of a key when its g-cost was
+	 *       <em>m_gCost</em>, ordered so that std::priority_queue
+	 *       gives the lowest one
+	 */
+	struct AnytimeBound
+	{
+	    AnytimeBound(const double fCost, const double gCost, const Key key)
+	    {
+		m_fCost = fCost;
+		m_gCost = gCost;
+		m_key   = key;
+	    }
+
+	    bool operator<(const AnytimeBound & other) const
+	    {
+		return m_fCost > other.m_fCost;
+	    }
+
+	    double m_fCost;
+	    double m_gCost;
+	    Key    m_key;
+	};
+
+	void ExpandBidirectional(const bool forward, double * const mu, Key * const meet);
+
+	void StatsBegin(Timer::Clock * const clk)
+	{
+	    m_nrExpansions = 0;
+	    if(m_stats)
+	    {
+		m_stats->Clear();
+		Timer::Start(clk);
+	    }
+	    if(m_trace)
+		m_trace->Clear();
+	}
+
+	void StatsEnd(Timer::Clock * const clk)
+	{
+	    if(m_stats)
+	    {
+		m_stats->m_nrExpanded = m_nrExpansions;
+		m_stats->m_time       = Timer::Elapsed(clk);
+	    }
+	}
+
+	void StatsExpand(const Key u, const double gCost)
+	{
+	    ++m_nrExpansions;
+	    m_info->PrintKey(u);
+	    if(m_trace)
+		m_trace->AddExpansion(u, gCost);
+	}
+
+	void StatsGenerate(const int heapSize)
+	{
+	    if(m_stats)
+	    {
+		++(m_stats->m_nrGenerated);
+		if(heapSize > m_stats->m_heapPeak)
+		    m_stats->m_heapPeak = heapSize;
+	    }
+	}
+
+	void StatsDecreaseKey(const int heapSize)
+	{
+	    if(m_stats)
+	    {
+		++(m_stats->m_nrDecreaseKeys);
+		if(heapSize > m_stats->m_heapPeak)
+		    m_stats->m_heapPeak = heapSize;
+	    }
+	}
+
+	double HeuristicCostToGoal(const Key u)
+	{
+	    if(m_stats)
+		++(m_stats->m_nrHeuristicEvals);
+	    return m_info->HeuristicCostToGoal(u);
+	}
+
+	double HeuristicCostFromStart(const Key u)
+	{
+	    if(m_stats)
+		++(m_stats->m_nrHeuristicEvals);
+	    return m_info->HeuristicCostFromStart(u);
+	}
+
 	MapDefault<Key, Data>              m_map;	
 	std::vector<Key>                   m_stack;
 	Heap<Key, MapDefault<Key, Data>* > m_heap;
+	MapDefault<Key, Data>              m_mapBackward;
+	Heap<Key, MapDefault<Key, Data>* > m_heapBackward;
+	MapDefault<Key, bool>              m_closed;
+	std::vector<Key>                   m_incons;
+	MapDefault<Key, Data>              m_goalMap;
+	Heap<Key, MapDefault<Key, Data>* > m_goalHeap;
+	Key                                m_goal;
+	int                                m_nrExpansions;
     };
 
     template <typename Key>
@@ -236,8 +471,8 @@ namespace Abetare
     template <typename Key>
     bool GraphSearch<Key>::LessFn(const Key u, const Key v, MapDefault<Key, Data> * const map)
     {
-	Data datau = map->GetData(u);
-	Data datav = map->GetData(v);
+	const Data & datau = map->GetData(u);
+	const Data & datav = map->GetData(v);
 	
 	return (datau.m_gCost + datau.m_hCost) < (datav.m_gCost + datav.m_hCost);
     }
@@ -251,33 +486,33 @@ namespace Abetare
 	bool hadv;	
 	std::vector<Key> edges;
 	std::vector<double> costs;
+	Timer::Clock clk;
 	
 	m_map.Clear();
 	m_heap.Clear();
+	StatsBegin(&clk);
 	
 	datau.m_parent= start;	
 	datau.m_gCost = 0;
-	datau.m_hCost = m_info->HeuristicCostToGoal(start);
+	datau.m_hCost = HeuristicCostToGoal(start);
 	m_map.Insert(start, datau);
 	m_heap.Insert(start);
-
-	m_info->PrintKey(start);
+	StatsGenerate(1);
 	
 	while(!m_heap.IsEmpty())
 	{
 	    u = m_heap.RemoveTop();
-	    m_info->PrintKey(u);
+	    datau = m_map.GetData(u);
+	    StatsExpand(u, datau.m_gCost);
 	    if(m_info->IsGoal(u))
 	    {
 		*goal = u;	
+		StatsEnd(&clk);
 		return true;
 	    }
 	    
 	    edges.clear();
 	    costs.clear();
-	    
-
-	    datau = m_map.GetData(u);
 	    m_info->GetOutEdges(u, &edges, &costs);
 
 	    const int n = edges.size();
@@ -294,13 +529,15 @@ namespace Abetare
 		{
 		    datav.m_parent = u;
 		    datav.m_gCost  = datau.m_gCost + w_uv;
-		    datav.m_hCost  = m_info->HeuristicCostToGoal(v);
+		    datav.m_hCost  = HeuristicCostToGoal(v);
 		    m_map.Insert(v, datav);
 		    m_heap.Insert(v);
+		    StatsGenerate(m_heap.GetNrKeys());
 
 		    if(breakEarly && m_info->IsGoal(v))
 		    {
 			*goal = v;
+			StatsEnd(&clk);
 			return true;
 		    }		    
 		}
@@ -309,12 +546,398 @@ namespace Abetare
 		    datav.m_parent= u;
 		    datav.m_gCost = datau.m_gCost + w_uv;
 		    m_map.Update(v, datav);
-		    m_heap.Update(v);
+		    if(m_heap.HasKey(v))
+			m_heap.Update(v);
+		    else
+			m_heap.Insert(v); //reopen when the heuristic is inconsistent
+		    StatsDecreaseKey(m_heap.GetNrKeys());
 		}
 	    }
 	}
+	StatsEnd(&clk);
 	return false;
     }
+
+    template <typename Key>
+    bool GraphSearch<Key>::BidirectionalAStar(const Key start, const Key goal)
+    {
+	Data   data;
+	double mu   = HUGE_VAL;
+	Key    meet = start;
+	Timer::Clock clk;
+	
+	m_map.Clear();
+	m_heap.Clear();
+	m_mapBackward.Clear();
+	m_heapBackward.Clear();
+	StatsBegin(&clk);
+
+	data.m_parent = start;
+	data.m_gCost  = 0;
+	data.m_hCost  = 0.5 * (HeuristicCostToGoal(start) - HeuristicCostFromStart(start));
+	m_map.Insert(start, data);
+	m_heap.Insert(start);
+	StatsGenerate(1);
+	if(start == goal)
+	{
+	    StatsEnd(&clk);
+	    return true;
+	}
+
+	data.m_parent = goal;
+	data.m_gCost  = 0;
+	data.m_hCost  = 0.5 * (HeuristicCostFromStart(goal) - HeuristicCostToGoal(goal));
+	m_mapBackward.Insert(goal, data);
+	m_heapBackward.Insert(goal);
+	StatsGenerate(2);
+
+	while(!m_heap.IsEmpty() && !m_heapBackward.IsEmpty())
+	{
+	    const Data & topf = m_map.GetData(m_heap.GetTop());
+	    const Data & topb = m_mapBackward.GetData(m_heapBackward.GetTop());
+	    
+	    if(mu <= topf.m_gCost + topf.m_hCost + topb.m_gCost + topb.m_hCost)
+		break;
+	    ExpandBidirectional(m_heap.GetNrKeys() <= m_heapBackward.GetNrKeys(), &mu, &meet);
+	}
+
+	StatsEnd(&clk);
+	if(mu == HUGE_VAL)
+	    return false;
+
+	//splice the backward path from the meeting key into the forward tree
+	Key    u  = meet;
+	double gu = m_map.GetData(meet).m_gCost;
+	double bu = m_mapBackward.GetData(meet).m_gCost;
+	
+	while(!(u == goal))
+	{
+	    const Key    v  = m_mapBackward.GetData(u).m_parent;
+	    const double bv = m_mapBackward.GetData(v).m_gCost;
+
+	    data.m_parent = u;
+	    data.m_gCost  = gu + (bu - bv);
+	    data.m_hCost  = 0;
+	    m_map.Insert(v, data);
+
+	    u  = v;
+	    gu = data.m_gCost;
+	    bu = bv;
+	}
+
+	return true;
+    }
+
+    template <typename Key>
+    bool GraphSearch<Key>::AnytimeAStar(const Key start, const double epsilon, const double decrease,
+					const double budget, Key * const goal, double * const bound)
+    {
+	Timer::Clock                      clk;
+	Data                              datau, datav;
+	bool                              hadv;
+	std::vector<Key>                  edges;
+	std::vector<double>               costs;
+	std::vector<Key>                  open;
+	std::priority_queue<AnytimeBound> bounds;
+	double                            eps     = epsilon > 1 ? epsilon : 1;
+	double                            gGoal   = HUGE_VAL;
+	bool                              expired = false;
+
+	//clearing the maps of the previous search counts against the budget
+	StatsBegin(&clk);
+	Timer::Start(&clk);
+	m_map.Clear();
+	m_heap.Clear();
+	m_incons.clear();
+	m_closed.Clear();
+	*bound = HUGE_VAL;
+
+	datau.m_parent = start;
+	datau.m_gCost  = 0;
+	datau.m_hCost  = HeuristicCostToGoal(start);
+	bounds.push(AnytimeBound(datau.m_hCost, 0, start));
+	datau.m_hCost *= eps;
+	m_map.Insert(start, datau);
+	m_heap.Insert(start);
+	StatsGenerate(1);
+	if(m_info->IsGoal(start))
+	{
+	    *goal = start;
+	    gGoal = 0;
+	}
+
+	while(!expired)
+	{
+	    //improve the path with the current weight
+	    while(!m_heap.IsEmpty())
+	    {
+		const Data & top = m_map.GetData(m_heap.GetTop());
+
+		if(gGoal <= top.m_gCost + top.m_hCost)
+		    break;
+		if((m_nrExpansions & 31) == 0 && Timer::Elapsed(&clk) > budget)
+		{
+		    expired = true;
+		    break;
+		}
+
+		const Key u = m_heap.RemoveTop();
+
+		datau = m_map.GetData(u);
+		StatsExpand(u, datau.m_gCost);
+		m_closed.Insert(u, true);
+
+		edges.clear();
+		costs.clear();
+		m_info->GetOutEdges(u, &edges, &costs);
+
+		const int n = edges.size();
+		for(int i = 0; i < n; ++i)
+		{
+		    const Key    v = edges[i];
+		    const double g = datau.m_gCost + costs[i];
+
+		    datav = m_map.GetData(v, datau, &hadv);
+		    if(hadv && !(g < datav.m_gCost))
+			continue;
+
+		    if(hadv)
+			StatsDecreaseKey(m_heap.GetNrKeys());
+		    datav.m_parent = u;
+		    datav.m_gCost  = g;
+		    if(m_closed.HasKey(v))
+		    {
+			//expanded with the current weight: wait for the next one
+			m_map.Insert(v, datav);
+			m_closed.Insert(v, false);
+			m_incons.push_back(v);
+			bounds.push(AnytimeBound(g + datav.m_hCost / eps, g, v));
+		    }
+		    else if(m_heap.HasKey(v))
+		    {
+			m_map.Insert(v, datav);
+			m_heap.Update(v);
+			bounds.push(AnytimeBound(g + datav.m_hCost / eps, g, v));
+		    }
+		    else
+		    {
+			const double h = HeuristicCostToGoal(v);
+
+			datav.m_hCost = eps * h;
+			m_map.Insert(v, datav);
+			m_heap.Insert(v);
+			bounds.push(AnytimeBound(g + h, g, v));
+			if(!hadv)
+			    StatsGenerate(m_heap.GetNrKeys());
+		    }
+
+		    if(g < gGoal && m_info->IsGoal(v))
+		    {
+			*goal = v;
+			gGoal = g;
+		    }
+		}
+	    }
+
+	    //some open or inconsistent key is on an optimal path, which
+	    //bounds the optimal cost; entries of keys that were expanded
+	    //since or whose cost dropped are discarded
+	    while(!bounds.empty())
+	    {
+		const AnytimeBound & b = bounds.top();
+
+		if(m_map.GetData(b.m_key).m_gCost == b.m_gCost &&
+		   (m_heap.HasKey(b.m_key) || !m_closed.GetData(b.m_key, true, &hadv)))
+		    break;
+		bounds.pop();
+	    }
+
+	    if(gGoal < HUGE_VAL)
+	    {
+		//a goal at cost 0 is optimal, and the lower bound is 0 then too
+		const double minf = bounds.empty() ? HUGE_VAL : bounds.top().m_fCost;
+		double       b    = gGoal <= 0 ? 1 : (minf > 0 ? gGoal / minf : HUGE_VAL);
+
+		if(!expired && eps < b)
+		    b = eps;
+		if(b < *bound)
+		    *bound = b > 1 ? b : 1;
+	    }
+
+	    if(expired || bounds.empty() || *bound == 1 || Timer::Elapsed(&clk) > budget)
+		break;
+
+	    //reweight the open and inconsistent keys, which takes as long
+	    //as a round of expansions, so the budget is checked here too
+	    eps = decrease > 0 && eps - decrease > 1 ? eps - decrease : 1;
+	    open.clear();
+	    for(int i = 0; i < m_heap.GetNrKeys(); ++i)
+		open.push_back(m_heap.GetKeyAtPosition(i));
+	    for(int i = 0; i < (int) m_incons.size(); ++i)
+		if(!m_closed.GetData(m_incons[i], true, &hadv))
+		{
+		    m_closed.Insert(m_incons[i], true);
+		    open.push_back(m_incons[i]);
+		}
+	    m_incons.clear();
+	    m_closed.Clear();
+	    m_heap.Clear();
+	    for(int i = 0; i < (int) open.size() && !expired; ++i)
+	    {
+		m_map.GetDataPointer(open[i])->m_hCost = eps * HeuristicCostToGoal(open[i]);
+		m_heap.Insert(open[i]);
+		expired = (i & 1023) == 1023 && Timer::Elapsed(&clk) > budget;
+	    }
+	}
+
+	StatsEnd(&clk);
+	return gGoal < HUGE_VAL;
+    }
+
+    template <typename Key>
+    void GraphSearch<Key>::SearchBackwardFromGoal(const Key goal, const double maxCost)
+    {
+	Data                datau, datav;
+	bool                hadv;
+	std::vector<Key>    edges;
+	std::vector<double> costs;
+	Timer::Clock        clk;
+
+	m_goalMap.Clear();
+	m_goalHeap.Clear();
+	StatsBegin(&clk);
+	m_goal = goal;
+
+	datau.m_parent = goal;
+	datau.m_gCost  = 0;
+	datau.m_hCost  = 0;
+	m_goalMap.Insert(goal, datau);
+	m_goalHeap.Insert(goal);
+	StatsGenerate(1);
+
+	//keys left in the heap are not settled and are not part of the tree
+	while(!m_goalHeap.IsEmpty() && m_goalMap.GetData(m_goalHeap.GetTop()).m_gCost <= maxCost)
+	{
+	    const Key u = m_goalHeap.RemoveTop();
+
+	    datau = m_goalMap.GetData(u);
+	    StatsExpand(u, datau.m_gCost);
+
+	    edges.clear();
+	    costs.clear();
+	    m_info->GetInEdges(u, &edges, &costs);
+
+	    const int n = edges.size();
+	    for(int i = 0; i < n; ++i)
+	    {
+		const Key    v = edges[i];
+		const double g = datau.m_gCost + costs[i];
+
+		datav = m_goalMap.GetData(v, datau, &hadv);
+		if(hadv && !(g < datav.m_gCost))
+		    continue;
+
+		datav.m_parent = u;
+		datav.m_gCost  = g;
+		datav.m_hCost  = 0;
+		m_goalMap.Insert(v, datav);
+		if(!hadv)
+		{
+		    m_goalHeap.Insert(v);
+		    StatsGenerate(m_goalHeap.GetNrKeys());
+		}
+		else if(m_goalHeap.HasKey(v))
+		{
+		    m_goalHeap.Update(v);
+		    StatsDecreaseKey(m_goalHeap.GetNrKeys());
+		}
+	    }
+	}
+	StatsEnd(&clk);
+    }
+
+    template <typename Key>
+    bool GraphSearch<Key>::GetPathToGoal(const Key start, std::vector<Key> * const path)
+    {
+	if(IsInGoalTree(start))
+	{
+	    Key u = start;
+
+	    path->push_back(u);
+	    while(!(u == m_goal))
+	    {
+		u = m_goalMap.GetData(u).m_parent;
+		path->push_back(u);
+	    }
+
+	    return true;
+	}
+
+	Key goal;
+
+	if(!AStar(start, false, &goal))
+	    return false;
+	GetPathFromStart(goal, path);
+
+	return true;
+    }
+
+    template <typename Key>
+    void GraphSearch<Key>::ExpandBidirectional(const bool forward, double * const mu, Key * const meet)
+    {
+	MapDefault<Key, Data>              *map   = forward ? &m_map : &m_mapBackward;
+	MapDefault<Key, Data>              *other = forward ? &m_mapBackward : &m_map;
+	Heap<Key, MapDefault<Key, Data>* > *heap  = forward ? &m_heap : &m_heapBackward;
+	std::vector<Key>                    edges;
+	std::vector<double>                 costs;
+	Data                                datav;
+	bool                                hadv;
+	
+	const Key  u     = heap->RemoveTop();
+	const Data datau = map->GetData(u);
+
+	StatsExpand(u, datau.m_gCost);
+	if(forward)
+	    m_info->GetOutEdges(u, &edges, &costs);
+	else
+	    m_info->GetInEdges(u, &edges, &costs);
+
+	const int n = edges.size();
+	for(int i = 0; i < n; ++i)
+	{
+	    const Key    v = edges[i];
+	    const double g = datau.m_gCost + costs[i];
+
+	    datav = map->GetData(v, datau, &hadv);
+	    if(hadv && !(g < datav.m_gCost))
+		continue;
+
+	    datav.m_parent = u;
+	    datav.m_gCost  = g;
+	    if(!hadv)
+	    {
+		datav.m_hCost = 0.5 * (HeuristicCostToGoal(v) - HeuristicCostFromStart(v));
+		if(!forward)
+		    datav.m_hCost = -datav.m_hCost;
+	    }
+	    map->Insert(v, datav);
+	    if(heap->HasKey(v))
+		heap->Update(v);
+	    else
+		heap->Insert(v);
+	    if(hadv)
+		StatsDecreaseKey(m_heap.GetNrKeys() + m_heapBackward.GetNrKeys());
+	    else
+		StatsGenerate(m_heap.GetNrKeys() + m_heapBackward.GetNrKeys());
+
+	    const Data *datao = other->GetDataPointer(v);
+	    if(datao != NULL && g + datao->m_gCost < *mu)
+	    {
+		*mu   = g + datao->m_gCost;
+		*meet = v;
+	    }
+	}
+    }
     
 }
 
@@ -0,0 +1,161 @@
+#ifndef ABETARE__GRAPH_SEARCH_STATS_HPP_
+#define ABETARE__GRAPH_SEARCH_STATS_HPP_
+
+#include "Utils/PrintMsg.hpp"
+#include <vector>
+#include <cstdio>
+#include <cstring>
+
+namespace Abetare
+{
+    /**
+     *@brief Counters filled by a search when attached to it
+     */
+    struct GraphSearchStats
+    {
+	GraphSearchStats(void)
+	{
+	    Clear();
+	}
+
+	void Clear(void)
+	{
+	    m_nrExpanded       = 0;
+	    m_nrGenerated      = 0;
+	    m_nrDecreaseKeys   = 0;
+	    m_nrHeuristicEvals = 0;
+	    m_heapPeak         = 0;
+	    m_time             = 0;
+	}
+
+	void Print(FILE * const out) const
+	{
+	    fprintf(out, "expanded=%ld generated=%ld decreaseKeys=%ld heuristicEvals=%ld heapPeak=%d time=%f\n",
+		    m_nrExpanded, m_nrGenerated, m_nrDecreaseKeys, m_nrHeuristicEvals, m_heapPeak, m_time);
+	}
+
+	long   m_nrExpanded;
+	long   m_nrGenerated;
+	long   m_nrDecreaseKeys;
+	long   m_nrHeuristicEvals;
+	int    m_heapPeak;
+	double m_time;
+    };
+
+    /**
+     *@brief Keys in the order they were expanded, with their g-costs
+     *
+     *@par Description:
+     *  The binary file starts with the four bytes <em>ABTR</em>, the
+     *  size of a key and the number of expansions as 32-bit integers,
+     *  followed by the raw bytes of each key and its g-cost as a
+     *  32-bit float. Keys are written as they are in memory, so they
+     *  must not contain pointers.
+     */
+    template <typename Key>
+    class GraphSearchTrace
+    {
+    public:
+	GraphSearchTrace(void)
+	{
+	}
+
+	virtual ~GraphSearchTrace(void)
+	{
+	}
+
+	void Clear(void)
+	{
+	    m_keys.clear();
+	    m_gCosts.clear();
+	}
+
+	void AddExpansion(const Key u, const double gCost)
+	{
+	    m_keys.push_back(u);
+	    m_gCosts.push_back((float) gCost);
+	}
+
+	int GetNrExpansions(void) const
+	{
+	    return m_keys.size();
+	}
+
+	Key GetKey(const int i) const
+	{
+	    return m_keys[i];
+	}
+
+	double GetGCost(const int i) const
+	{
+	    return m_gCosts[i];
+	}
+
+	bool Write(const char fname[]) const
+	{
+	    FILE *out = fopen(fname, "wb");
+
+	    if(out == NULL)
+	    {
+		PrintError(printf("could not open file <%s> for writing\n", fname));
+		return false;
+	    }
+
+	    const int header[2] = {(int) sizeof(Key), GetNrExpansions()};
+
+	    fwrite("ABTR", 1, 4, out);
+	    fwrite(header, sizeof(int), 2, out);
+	    for(int i = 0; i < GetNrExpansions(); ++i)
+	    {
+		fwrite(&m_keys[i], sizeof(Key), 1, out);
+		fwrite(&m_gCosts[i], sizeof(float), 1, out);
+	    }
+	    fclose(out);
+
+	    return true;
+	}
+
+	bool Read(const char fname[])
+	{
+	    FILE *in = fopen(fname, "rb");
+	    char  magic[4];
+	    int   header[2];
+
+	    Clear();
+	    if(in == NULL)
+	    {
+		PrintError(printf("could not open file <%s> for reading\n", fname));
+		return false;
+	    }
+
+	    bool ok = fread(magic, 1, 4, in) == 4 && memcmp(magic, "ABTR", 4) == 0 &&
+		fread(header, sizeof(int), 2, in) == 2 && header[0] == (int) sizeof(Key) && header[1] >= 0;
+
+	    for(int i = 0; ok && i < header[1]; ++i)
+	    {
+		Key   u;
+		float g;
+
+		ok = fread(&u, sizeof(Key), 1, in) == 1 && fread(&g, sizeof(float), 1, in) == 1;
+		if(ok)
+		{
+		    m_keys.push_back(u);
+		    m_gCosts.push_back(g);
+		}
+	    }
+	    fclose(in);
+	    if(!ok)
+	    {
+		PrintError(printf("invalid trace file <%s>\n", fname));
+	    }
+
+	    return ok;
+	}
+
+    protected:
+	std::vector<Key>   m_keys;
+	std::vector<float> m_gCosts;
+    };
+}
+
+#endif
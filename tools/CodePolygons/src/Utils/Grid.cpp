@@ -1,4 +1,5 @@
 #include "Utils/Grid.hpp"
+#include "Utils/Constants.hpp"
 #include <cstdlib>
 
 namespace Abetare
@@ -71,6 +72,19 @@ namespace Abetare
 	return id;	
     }
     
+    bool Grid::GetCoordsIfInside(const double p[], int coords[]) const
+    {
+	if(!IsPointInside(p))
+	    return false;
+	GetCoords(p, coords);
+	return true;
+    }
+
+    int Grid::GetCellIdIfInside(const double p[]) const
+    {
+	return IsPointInside(p) ? GetCellId(p) : Constants::ID_UNDEFINED;
+    }
+    
     void Grid::GetCellFromCoords(const int coords[], 
 				 double    min[], 
 				 double    max[]) const
@@ -92,6 +92,19 @@ namespace Abetare
 	virtual void GetCoords(const double p[], int coords[]) const;
 	
 	virtual int GetCellId(const double p[]) const;
+
+	/**
+	 *@brief Same as <em>GetCoords</em>, but returns false instead of
+	 *       clamping to the border cells when <em>p</em> is outside
+	 */
+	virtual bool GetCoordsIfInside(const double p[], int coords[]) const;
+
+	/**
+	 *@brief Same as <em>GetCellId</em>, but returns
+	 *       <em>Constants::ID_UNDEFINED</em> instead of clamping to the
+	 *       border cells when <em>p</em> is outside
+	 */
+	virtual int GetCellIdIfInside(const double p[]) const;
 	
 	virtual void GetCellFromCoords(const int coords[], 
 				       double    min[], 
@@ -116,6 +129,7 @@ namespace Abetare
 	virtual void GetNeighs(const int id, const int coords[], std::vector<int> *neighs);
 	
     protected:
+	//points outside the grid are clamped to the border cells
 	static int GetCoord(const double x, 
 			    const double min,
 			    const double max,
@@ -0,0 +1,80 @@
+#include "Utils/GridSearchInfo.hpp"
+
+namespace Abetare
+{
+    void GridSearchInfo::Setup(const Grid * const grid, const bool occupied[])
+    {
+	m_grid = grid;
+	m_dimX = grid->GetDims()[0];
+	m_dimY = grid->GetDims()[1];
+	m_occupied.resize(grid->GetNrCells());
+	for(int i = 0; i < (int) m_occupied.size(); ++i)
+	    m_occupied[i] = occupied[i];
+    }
+
+    void GridSearchInfo::GetOutEdges(const int u,
+				     std::vector<int> * const edges,
+				     std::vector<double> * const costs) const
+    {
+	if(m_occupied[u])
+	    return;
+
+	const int  x     = u % m_dimX;
+	const int  y     = u / m_dimX;
+	const bool free0 = IsFree(x + 1, y);
+	const bool free1 = IsFree(x, y + 1);
+	const bool free2 = IsFree(x - 1, y);
+	const bool free3 = IsFree(x, y - 1);
+
+	if(free0)
+	{
+	    edges->push_back(u + 1);
+	    if(costs)
+		costs->push_back(1);
+	}
+	if(free1)
+	{
+	    edges->push_back(u + m_dimX);
+	    if(costs)
+		costs->push_back(1);
+	}
+	if(free2)
+	{
+	    edges->push_back(u - 1);
+	    if(costs)
+		costs->push_back(1);
+	}
+	if(free3)
+	{
+	    edges->push_back(u - m_dimX);
+	    if(costs)
+		costs->push_back(1);
+	}
+
+	//diagonal moves must not cut corners
+	if(free0 && free1 && IsFree(x + 1, y + 1))
+	{
+	    edges->push_back(u + m_dimX + 1);
+	    if(costs)
+		costs->push_back(M_SQRT2);
+	}
+	if(free1 && free2 && IsFree(x - 1, y + 1))
+	{
+	    edges->push_back(u + m_dimX - 1);
+	    if(costs)
+		costs->push_back(M_SQRT2);
+	}
+	if(free2 && free3 && IsFree(x - 1, y - 1))
+	{
+	    edges->push_back(u - m_dimX - 1);
+	    if(costs)
+		costs->push_back(M_SQRT2);
+	}
+	if(free3 && free0 && IsFree(x + 1, y - 1))
+	{
+	    edges->push_back(u - m_dimX + 1);
+	    if(costs)
+		costs->push_back(M_SQRT2);
+	}
+    }
+}
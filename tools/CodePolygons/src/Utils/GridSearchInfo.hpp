@@ -0,0 +1,138 @@
+#ifndef ABETARE__GRID_SEARCH_INFO_HPP_
+#define ABETARE__GRID_SEARCH_INFO_HPP_
+
+#include "Utils/GraphSearch.hpp"
+#include "Utils/Grid.hpp"
+#include "Utils/Constants.hpp"
+#include <vector>
+#include <cstdlib>
+#include <cmath>
+
+namespace Abetare
+{
+    /**
+     *@brief Search over the free cells of a 2D occupancy grid
+     *
+     *@par Description:
+     *  Keys are cell ids. Each free cell is connected to its free 8
+     *  neighbors, with unit cost for horizontal and vertical moves and
+     *  <em>sqrt(2)</em> for diagonal moves. A diagonal move is allowed
+     *  only when both cells it passes by are free, so paths do not cut
+     *  corners. The heuristics are octile distances, which are
+     *  consistent.
+     */
+    class GridSearchInfo : public GraphSearchInfo<int>
+    {
+    public:
+	GridSearchInfo(void) : GraphSearchInfo<int>()
+	{
+	    m_grid  = NULL;
+	    m_start = Constants::ID_UNDEFINED;
+	    m_goal  = Constants::ID_UNDEFINED;
+	}
+
+	virtual ~GridSearchInfo(void)
+	{
+	}
+
+	/**
+	 *@brief Set the grid and mark cell <em>i</em> as an obstacle
+	 *       when <em>occupied[i]</em> is true
+	 */
+	virtual void Setup(const Grid * const grid, const bool occupied[]);
+
+	const Grid* GetGrid(void) const
+	{
+	    return m_grid;
+	}
+
+	int GetDimX(void) const
+	{
+	    return m_dimX;
+	}
+
+	int GetDimY(void) const
+	{
+	    return m_dimY;
+	}
+
+	void SetOccupied(const int id, const bool occupied)
+	{
+	    m_occupied[id] = occupied;
+	}
+
+	bool IsOccupied(const int id) const
+	{
+	    return m_occupied[id] != 0;
+	}
+
+	/**
+	 *@brief Returns true if <em>(x, y)</em> is inside the grid and free
+	 */
+	bool IsFree(const int x, const int y) const
+	{
+	    return x >= 0 && y >= 0 && x < m_dimX && y < m_dimY && m_occupied[y * m_dimX + x] == 0;
+	}
+
+	void SetStart(const int start)
+	{
+	    m_start = start;
+	}
+
+	int GetStart(void) const
+	{
+	    return m_start;
+	}
+
+	void SetGoal(const int goal)
+	{
+	    m_goal = goal;
+	}
+
+	int GetGoal(void) const
+	{
+	    return m_goal;
+	}
+
+	virtual void GetOutEdges(const int u,
+				 std::vector<int> * const edges,
+				 std::vector<double> * const costs = NULL) const;
+
+	virtual bool IsGoal(const int key) const
+	{
+	    return key == m_goal;
+	}
+
+	virtual double HeuristicCostToGoal(const int u) const
+	{
+	    return OctileDistance(u, m_goal);
+	}
+
+	virtual double HeuristicCostFromStart(const int u) const
+	{
+	    return OctileDistance(m_start, u);
+	}
+
+	/**
+	 *@brief Length of a shortest 8-connected path between the two
+	 *       cells when there are no obstacles
+	 */
+	double OctileDistance(const int u, const int v) const
+	{
+	    const int dx = abs(u % m_dimX - v % m_dimX);
+	    const int dy = abs(u / m_dimX - v / m_dimX);
+
+	    return dx < dy ? (M_SQRT2 - 1) * dx + dy : (M_SQRT2 - 1) * dy + dx;
+	}
+
+    protected:
+	const Grid                *m_grid;
+	int                        m_dimX;
+	int                        m_dimY;
+	std::vector<unsigned char> m_occupied;
+	int                        m_start;
+	int                        m_goal;
+    };
+}
+
+#endif
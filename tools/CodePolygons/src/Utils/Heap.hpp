@@ -94,11 +94,14 @@ namespace Abetare
 	    const int size = m_heap.size();
 	    
 	    m_heap[pos] = m_heap[size - 1];
-	    m_heap.pop_back(); 
-	    m_map.Update(m_heap[pos], pos);
+	    m_heap.pop_back();
 	    m_map.Remove(key);
 	    if(pos < size - 1)
-		PrecolateDown(pos);    
+	    {
+		//the last key may belong above or below the removed one
+		m_map.Update(m_heap[pos], pos);
+		UpdateAtPosition(pos);
+	    }
 	}
 
 	void Clear(void)
@@ -0,0 +1,236 @@
+#include "Utils/JumpPointSearch.hpp"
+#include "Utils/Misc.hpp"
+
+namespace Abetare
+{
+    void JumpPointSearch::Setup(const GridSearchInfo * const info)
+    {
+	const int n = info->GetDimX() * info->GetDimY();
+
+	m_info = info;
+	m_dimX = info->GetDimX();
+	m_parents.resize(n);
+	m_gCosts.resize(n);
+	m_stamps.assign(n, 0);
+	m_stamp = 0;
+	m_heap.Setup(n);
+    }
+
+    bool JumpPointSearch::Search(const int start, const int goal)
+    {
+	std::vector<int> dirs;
+
+	m_heap.Clear();
+	if(++m_stamp == 0)
+	{
+	    m_stamps.assign(m_stamps.size(), 0);
+	    m_stamp = 1;
+	}
+	m_goal         = goal;
+	m_nrExpansions = 0;
+
+	m_stamps[start]  = m_stamp;
+	m_parents[start] = start;
+	m_gCosts[start]  = 0;
+	m_heap.Insert(start, m_info->OctileDistance(start, goal));
+
+	while(!m_heap.IsEmpty())
+	{
+	    const int u = m_heap.RemoveTop();
+
+	    ++m_nrExpansions;
+	    if(u == goal)
+		return true;
+
+	    const int x = u % m_dimX;
+	    const int y = u / m_dimX;
+
+	    dirs.clear();
+	    GetSuccessorDirs(u, &dirs);
+	    for(int i = 0; i < (int) dirs.size(); i += 2)
+	    {
+		const int v = Jump(x + dirs[i], y + dirs[i + 1], dirs[i], dirs[i + 1]);
+
+		if(v < 0)
+		    continue;
+
+		//jumps are along straight or diagonal lines
+		const double g = m_gCosts[u] + m_info->OctileDistance(u, v);
+
+		if(m_stamps[v] != m_stamp)
+		{
+		    m_stamps[v]  = m_stamp;
+		    m_parents[v] = u;
+		    m_gCosts[v]  = g;
+		    m_heap.Insert(v, g + m_info->OctileDistance(v, goal));
+		}
+		else if(g < m_gCosts[v])
+		{
+		    m_parents[v] = u;
+		    m_gCosts[v]  = g;
+		    m_heap.InsertOrUpdate(v, g + m_info->OctileDistance(v, goal));
+		}
+	    }
+	}
+
+	return false;
+    }
+
+    int JumpPointSearch::Jump(int x, int y, const int dx, const int dy) const
+    {
+	for(;; x += dx, y += dy)
+	{
+	    //diagonal moves must not cut corners
+	    if(!m_info->IsFree(x, y) ||
+	       (dx != 0 && dy != 0 && (!m_info->IsFree(x - dx, y) || !m_info->IsFree(x, y - dy))))
+		return -1;
+
+	    const int id = y * m_dimX + x;
+
+	    if(id == m_goal)
+		return id;
+
+	    if(dx != 0 && dy != 0)
+	    {
+		//a diagonal jump stops where a straight jump finds a jump point
+		if(Jump(x + dx, y, dx, 0) >= 0 || Jump(x, y + dy, 0, dy) >= 0)
+		    return id;
+	    }
+	    else if(dx != 0)
+	    {
+		if((m_info->IsFree(x, y - 1) && !m_info->IsFree(x - dx, y - 1)) ||
+		   (m_info->IsFree(x, y + 1) && !m_info->IsFree(x - dx, y + 1)))
+		    return id;
+	    }
+	    else
+	    {
+		if((m_info->IsFree(x - 1, y) && !m_info->IsFree(x - 1, y - dy)) ||
+		   (m_info->IsFree(x + 1, y) && !m_info->IsFree(x + 1, y - dy)))
+		    return id;
+	    }
+	}
+    }
+
+    void JumpPointSearch::GetSuccessorDirs(const int u, std::vector<int> * const dirs) const
+    {
+	const int x = u % m_dimX;
+	const int y = u / m_dimX;
+	const int p = m_parents[u];
+
+	if(p == u)
+	{
+	    //the start follows all the 8 directions
+	    for(int dy = -1; dy <= 1; ++dy)
+		for(int dx = -1; dx <= 1; ++dx)
+		    if(dx != 0 || dy != 0)
+		    {
+			dirs->push_back(dx);
+			dirs->push_back(dy);
+		    }
+	    return;
+	}
+
+	const int px = p % m_dimX;
+	const int py = p / m_dimX;
+	const int dx = x > px ? 1 : (x < px ? -1 : 0);
+	const int dy = y > py ? 1 : (y < py ? -1 : 0);
+
+	if(dx != 0 && dy != 0)
+	{
+	    dirs->push_back(dx);
+	    dirs->push_back(0);
+	    dirs->push_back(0);
+	    dirs->push_back(dy);
+	    dirs->push_back(dx);
+	    dirs->push_back(dy);
+	}
+	else if(dx != 0)
+	{
+	    const bool up   = m_info->IsFree(x, y + 1);
+	    const bool down = m_info->IsFree(x, y - 1);
+
+	    dirs->push_back(dx);
+	    dirs->push_back(0);
+	    if(up)
+	    {
+		dirs->push_back(0);
+		dirs->push_back(1);
+		dirs->push_back(dx);
+		dirs->push_back(1);
+	    }
+	    if(down)
+	    {
+		dirs->push_back(0);
+		dirs->push_back(-1);
+		dirs->push_back(dx);
+		dirs->push_back(-1);
+	    }
+	}
+	else
+	{
+	    const bool right = m_info->IsFree(x + 1, y);
+	    const bool left  = m_info->IsFree(x - 1, y);
+
+	    dirs->push_back(0);
+	    dirs->push_back(dy);
+	    if(right)
+	    {
+		dirs->push_back(1);
+		dirs->push_back(0);
+		dirs->push_back(1);
+		dirs->push_back(dy);
+	    }
+	    if(left)
+	    {
+		dirs->push_back(-1);
+		dirs->push_back(0);
+		dirs->push_back(-1);
+		dirs->push_back(dy);
+	    }
+	}
+    }
+
+    void JumpPointSearch::GetJumpPointsFromStart(const int u, std::vector<int> * const path) const
+    {
+	if(m_stamps[u] != m_stamp)
+	    return;
+
+	int p = u, v;
+
+	do
+	{
+	    v = p;
+	    path->push_back(v);
+	    p = m_parents[v];
+	}
+	while(v != p);
+	ReverseItems<int>(path);
+    }
+
+    void JumpPointSearch::GetPathFromStart(const int u, std::vector<int> * const path) const
+    {
+	std::vector<int> jpts;
+
+	GetJumpPointsFromStart(u, &jpts);
+	if(jpts.empty())
+	    return;
+
+	path->push_back(jpts[0]);
+	for(int i = 1; i < (int) jpts.size(); ++i)
+	{
+	    int       x  = jpts[i - 1] % m_dimX;
+	    int       y  = jpts[i - 1] / m_dimX;
+	    const int tx = jpts[i] % m_dimX;
+	    const int ty = jpts[i] / m_dimX;
+	    const int dx = tx > x ? 1 : (tx < x ? -1 : 0);
+	    const int dy = ty > y ? 1 : (ty < y ? -1 : 0);
+
+	    while(x != tx || y != ty)
+	    {
+		x += dx;
+		y += dy;
+		path->push_back(y * m_dimX + x);
+	    }
+	}
+    }
+}
@@ -0,0 +1,95 @@
+#ifndef ABETARE__JUMP_POINT_SEARCH_HPP_
+#define ABETARE__JUMP_POINT_SEARCH_HPP_
+
+#include "Utils/GridSearchInfo.hpp"
+#include "Utils/DaryHeap.hpp"
+#include <vector>
+
+namespace Abetare
+{
+    /**
+     *@brief Jump Point Search over the free cells of a 2D grid
+     *
+     *@par Description:
+     *  Finds the same path costs as A* over <em>GridSearchInfo</em>
+     *  (8-connected, no corner cutting), but instead of adding every
+     *  neighbor to the open list it only follows the directions that
+     *  can start a shortest path and jumps along straight and diagonal
+     *  lines until reaching the goal or a cell with a forced neighbor.
+     *  Only these jump points are expanded, which skips most cells of
+     *  open regions. The occupancy is read from the search info, so
+     *  changes to it are seen by the next search.
+     */
+    class JumpPointSearch
+    {
+    public:
+	JumpPointSearch(void)
+	{
+	    m_info         = NULL;
+	    m_stamp        = 0;
+	    m_nrExpansions = 0;
+	}
+
+	virtual ~JumpPointSearch(void)
+	{
+	}
+
+	/**
+	 *@brief Allocate the search arrays for the grid of <em>info</em>
+	 */
+	virtual void Setup(const GridSearchInfo * const info);
+
+	/**
+	 *@brief Search for a shortest path from cell <em>start</em> to
+	 *       cell <em>goal</em>
+	 */
+	bool Search(const int start, const int goal);
+
+	/**
+	 *@brief Get the jump points of the path, from the start to <em>u</em>
+	 */
+	void GetJumpPointsFromStart(const int u, std::vector<int> * const path) const;
+
+	/**
+	 *@brief Get all the cells of the path, from the start to <em>u</em>
+	 */
+	void GetPathFromStart(const int u, std::vector<int> * const path) const;
+
+	double GetPathCostFromStart(const int u) const
+	{
+	    return m_stamps[u] == m_stamp ? m_gCosts[u] : HUGE_VAL;
+	}
+
+	/**
+	 *@brief Number of jump points expanded by the last search
+	 */
+	int GetNrExpansions(void) const
+	{
+	    return m_nrExpansions;
+	}
+
+    protected:
+	/**
+	 *@brief Follow direction <em>(dx, dy)</em> from <em>(x, y)</em>
+	 *       and return the first jump point or -1 if there is none
+	 */
+	int Jump(int x, int y, const int dx, const int dy) const;
+
+	/**
+	 *@brief Get the directions to follow from <em>u</em> given its parent
+	 */
+	void GetSuccessorDirs(const int u, std::vector<int> * const dirs) const;
+
+	const GridSearchInfo     *m_info;
+	int                       m_dimX;
+	int                       m_goal;
+	std::vector<int>          m_parents;
+	std::vector<double>       m_gCosts;
+	std::vector<unsigned int> m_stamps;
+	unsigned int              m_stamp;
+	DaryHeap<4>               m_heap;
+	int                       m_nrExpansions;
+    };
+}
+
+#endif
@@ -0,0 +1,295 @@
+#include "Utils/KDTree2D.hpp"
+#include "Utils/Parallel.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace Abetare
+{
+    //a subtree is rebuilt when one side holds more than this fraction of its points
+    static const double KDTREE_BALANCE = 0.7;
+
+    void KDTree2D::Build(const int n, const double pts[])
+    {
+	m_points.assign(pts, pts + 2 * n);
+	Rebuild();
+    }
+
+    void KDTree2D::Rebuild(void)
+    {
+	const int        n = GetNrPoints();
+	std::vector<int> ids(n);
+
+	for(int i = 0; i < n; ++i)
+	    ids[i] = i;
+
+	m_nodes.clear();
+	m_buckets.clear();
+	m_nodes.reserve(4 * n / (m_leafSize > 0 ? m_leafSize : 1) + 1);
+	m_buckets.reserve(m_nodes.capacity());
+	m_nodes.resize(1);
+	m_buckets.resize(1);
+	m_nrGarbage = 0;
+	BuildNode(0, n > 0 ? &ids[0] : NULL, n);
+    }
+
+    void KDTree2D::BuildNode(const int node, int ids[], const int n)
+    {
+	m_nodes[node].m_count = n;
+	if(n <= m_leafSize)
+	{
+	    m_nodes[node].m_child = -1;
+	    m_buckets[node].assign(ids, ids + n);
+	    return;
+	}
+	std::vector<int>().swap(m_buckets[node]);
+
+	double xmin = m_points[2 * ids[0]];
+	double xmax = xmin;
+	double ymin = m_points[2 * ids[0] + 1];
+	double ymax = ymin;
+
+	for(int i = 1; i < n; ++i)
+	{
+	    const double *p = &(m_points[2 * ids[i]]);
+
+	    xmin = std::min(xmin, p[0]);
+	    xmax = std::max(xmax, p[0]);
+	    ymin = std::min(ymin, p[1]);
+	    ymax = std::max(ymax, p[1]);
+	}
+
+	const int axis  = xmax - xmin >= ymax - ymin ? 0 : 1;
+	const int mid   = n / 2;
+	const int child = m_nodes.size();
+
+	//points on the left are at most the split, those on the right at least
+	std::nth_element(ids, ids + mid, ids + n, [&](const int a, const int b)
+			 {
+			     return m_points[2 * a + axis] < m_points[2 * b + axis];
+			 });
+
+	m_nodes.resize(child + 2);
+	m_buckets.resize(child + 2);
+	m_nodes[node].m_axis  = axis;
+	m_nodes[node].m_split = m_points[2 * ids[mid] + axis];
+	m_nodes[node].m_child = child;
+
+	BuildNode(child, ids, mid);
+	BuildNode(child + 1, ids + mid, n - mid);
+    }
+
+    void KDTree2D::CollectIds(const int node, std::vector<int> * const ids)
+    {
+	const int child = m_nodes[node].m_child;
+
+	if(child < 0)
+	{
+	    ids->insert(ids->end(), m_buckets[node].begin(), m_buckets[node].end());
+	    return;
+	}
+
+	for(int c = child; c <= child + 1; ++c)
+	{
+	    CollectIds(c, ids);
+	    std::vector<int>().swap(m_buckets[c]);
+	    ++m_nrGarbage;
+	}
+    }
+
+    int KDTree2D::AddPoint(const double p[2])
+    {
+	const int id = GetNrPoints();
+	int       node;
+
+	m_points.push_back(p[0]);
+	m_points.push_back(p[1]);
+	if(m_nodes.empty())
+	{
+	    m_nodes.resize(1);
+	    m_buckets.resize(1);
+	    m_nodes[0].m_child = -1;
+	    m_nodes[0].m_count = 0;
+	}
+
+	for(node = 0; ; node = m_nodes[node].m_child + (p[m_nodes[node].m_axis] < m_nodes[node].m_split ? 0 : 1))
+	{
+	    ++m_nodes[node].m_count;
+	    if(m_nodes[node].m_child < 0)
+		break;
+	}
+	m_buckets[node].push_back(id);
+
+	//rebuild the highest unbalanced subtree on the path, or else split the leaf
+	for(int v = 0; m_nodes[v].m_child >= 0; )
+	{
+	    const int c = m_nodes[v].m_child + (p[m_nodes[v].m_axis] < m_nodes[v].m_split ? 0 : 1);
+
+	    if(m_nodes[c].m_count > KDTREE_BALANCE * m_nodes[v].m_count + m_leafSize)
+	    {
+		node = v;
+		break;
+	    }
+	    v = c;
+	}
+
+	if(m_nodes[node].m_child >= 0 || (int) m_buckets[node].size() > m_leafSize)
+	{
+	    std::vector<int> ids;
+
+	    CollectIds(node, &ids);
+	    BuildNode(node, &ids[0], ids.size());
+	}
+
+	//most nodes are left over from rebuilt subtrees
+	if(2 * m_nrGarbage > (int) m_nodes.size())
+	    Rebuild();
+
+	return id;
+    }
+
+    void KDTree2D::KNearest(const int node, const double p[2], const int k, const int exclude,
+			    KNearestQueue * const best) const
+    {
+	const Node & nd = m_nodes[node];
+
+	if(nd.m_child < 0)
+	{
+	    const std::vector<int> & ids = m_buckets[node];
+
+	    for(int i = 0; i < (int) ids.size(); ++i)
+		if(ids[i] != exclude)
+		{
+		    const double dd = DistSquared(p, ids[i]);
+
+		    if((int) best->size() < k)
+			best->push(std::make_pair(dd, ids[i]));
+		    else if(dd < best->top().first)
+		    {
+			best->pop();
+			best->push(std::make_pair(dd, ids[i]));
+		    }
+		}
+	    return;
+	}
+
+	const double diff = p[nd.m_axis] - nd.m_split;
+
+	KNearest(nd.m_child + (diff < 0 ? 0 : 1), p, k, exclude, best);
+	if((int) best->size() < k || diff * diff < best->top().first)
+	    KNearest(nd.m_child + (diff < 0 ? 1 : 0), p, k, exclude, best);
+    }
+
+    void KDTree2D::NeighsInRadius(const int node, const double p[2], const double rr, const int exclude,
+				  std::vector<int> * const neighs) const
+    {
+	const Node & nd = m_nodes[node];
+
+	if(nd.m_child < 0)
+	{
+	    const std::vector<int> & ids = m_buckets[node];
+
+	    for(int i = 0; i < (int) ids.size(); ++i)
+		if(ids[i] != exclude && DistSquared(p, ids[i]) <= rr)
+		    neighs->push_back(ids[i]);
+	    return;
+	}
+
+	const double diff = p[nd.m_axis] - nd.m_split;
+
+	NeighsInRadius(nd.m_child + (diff < 0 ? 0 : 1), p, rr, exclude, neighs);
+	if(diff * diff <= rr)
+	    NeighsInRadius(nd.m_child + (diff < 0 ? 1 : 0), p, rr, exclude, neighs);
+    }
+
+    void KDTree2D::GetNeighsInRadius(const double p[2],
+				     const double r,
+				     std::vector<int> * const neighs,
+				     const int exclude) const
+    {
+	if(!m_nodes.empty())
+	    NeighsInRadius(0, p, r * r, exclude, neighs);
+    }
+
+    void KDTree2D::GetKNearest(const double p[2],
+			       const int k,
+			       std::vector<int> * const neighs,
+			       std::vector<double> * const dists,
+			       const int exclude) const
+    {
+	KNearestQueue best;
+
+	if(k <= 0 || m_nodes.empty())
+	    return;
+
+	KNearest(0, p, k, exclude, &best);
+
+	const int n      = best.size();
+	const int start  = neighs->size();
+	const int dstart = dists ? dists->size() : 0;
+
+	neighs->resize(start + n);
+	if(dists)
+	    dists->resize(dstart + n);
+	for(int i = n - 1; i >= 0; --i)
+	{
+	    (*neighs)[start + i] = best.top().second;
+	    if(dists)
+		(*dists)[dstart + i] = sqrt(best.top().first);
+	    best.pop();
+	}
+    }
+
+    void KDTree2D::GetKNearest(const int nrQueries,
+			       const double queries[],
+			       const int k,
+			       std::vector<int> * const neighs,
+			       std::vector<double> * const dists,
+			       const int excludes[],
+			       const int nrThreads) const
+    {
+	neighs->assign(k * nrQueries, -1);
+	if(dists)
+	    dists->assign(k * nrQueries, HUGE_VAL);
+	if(k <= 0 || m_nodes.empty())
+	    return;
+
+	ParallelFor(nrQueries, nrThreads, [&](const int q, const int t)
+		    {
+			KNearestQueue best;
+
+			KNearest(0, &(queries[2 * q]), k, excludes ? excludes[q] : -1, &best);
+			for(int i = best.size() - 1; i >= 0; --i)
+			{
+			    (*neighs)[k * q + i] = best.top().second;
+			    if(dists)
+				(*dists)[k * q + i] = sqrt(best.top().first);
+			    best.pop();
+			}
+		    }, 64);
+    }
+
+    void KDTree2D::GetNeighsInRadius(const int nrQueries,
+				     const double queries[],
+				     const double r,
+				     std::vector<int> * const starts,
+				     std::vector<int> * const neighs,
+				     const int excludes[],
+				     const int nrThreads) const
+    {
+	std::vector<std::vector<int> > found(nrQueries);
+
+	ParallelFor(nrQueries, nrThreads, [&](const int q, const int t)
+		    {
+			GetNeighsInRadius(&(queries[2 * q]), r, &(found[q]), excludes ? excludes[q] : -1);
+		    }, 64);
+
+	starts->resize(nrQueries + 1);
+	(*starts)[0] = 0;
+	for(int q = 0; q < nrQueries; ++q)
+	    (*starts)[q + 1] = (*starts)[q] + found[q].size();
+
+	neighs->resize((*starts)[nrQueries]);
+	for(int q = 0; q < nrQueries; ++q)
+	    std::copy(found[q].begin(), found[q].end(), neighs->begin() + (*starts)[q]);
+    }
+}
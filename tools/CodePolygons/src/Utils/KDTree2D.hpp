@@ -0,0 +1,184 @@
+#ifndef ABETARE__KDTREE_2D_HPP_
+#define ABETARE__KDTREE_2D_HPP_
+
+#include <vector>
+#include <queue>
+#include <cstdlib>
+
+namespace Abetare
+{
+    /**
+     *@brief k-d tree for nearest-neighbor queries among 2D points
+     *
+     *@par Description:
+     *  <em>Build</em> splits the points at the median of the coordinate
+     *  of largest extent until at most <em>m_leafSize</em> points are
+     *  left, so the tree is balanced and queries visit
+     *  <em>O(log N)</em> nodes on average, however the points are
+     *  distributed. Unlike <em>CellList</em>, it needs no grid tuned to
+     *  the density, which matters for samples clustered near obstacles.
+     *  \n\n
+     *  Points can also be added one at a time. They go down to a leaf,
+     *  which is split when full. A subtree with one side holding most of
+     *  its points is rebuilt, as in a scapegoat tree, so the depth stays
+     *  logarithmic for any insertion order.
+     *  \n\n
+     *  Queries do not modify the tree, so the batched queries run on
+     *  several threads.
+     */
+    class KDTree2D
+    {
+    public:
+	KDTree2D(void)
+	{
+	    m_leafSize  = 8;
+	    m_nrGarbage = 0;
+	}
+
+	virtual ~KDTree2D(void)
+	{
+	}
+
+	/**
+	 *@brief Maximum number of points in a leaf
+	 */
+	int m_leafSize;
+
+	/**
+	 *@brief Build the tree over the points
+	 *       <em>(pts[2 * i], pts[2 * i + 1])</em>, whose ids are
+	 *       their positions in <em>pts</em>
+	 */
+	virtual void Build(const int n, const double pts[]);
+
+	/**
+	 *@brief Add point <em>p</em> and return its id
+	 */
+	int AddPoint(const double p[2]);
+
+	int GetNrPoints(void) const
+	{
+	    return m_points.size() / 2;
+	}
+
+	const double* GetPoint(const int id) const
+	{
+	    return &(m_points[2 * id]);
+	}
+
+	/**
+	 *@brief Get the points within distance <em>r</em> from <em>p</em>
+	 *
+	 *@param exclude point id to leave out, e.g., the querying point
+	 */
+	void GetNeighsInRadius(const double p[2],
+			       const double r,
+			       std::vector<int> * const neighs,
+			       const int exclude = -1) const;
+
+	/**
+	 *@brief Get the <em>k</em> points nearest to <em>p</em>, ordered
+	 *       by increasing distance
+	 *
+	 *@param dists if not NULL, set to the corresponding distances
+	 *@param exclude point id to leave out, e.g., the querying point
+	 */
+	void GetKNearest(const double p[2],
+			 const int k,
+			 std::vector<int> * const neighs,
+			 std::vector<double> * const dists = NULL,
+			 const int exclude = -1) const;
+
+	/**
+	 *@brief Run <em>GetKNearest</em> for the points
+	 *       <em>queries[2 * q], queries[2 * q + 1]</em> on
+	 *       <em>nrThreads</em> threads
+	 *
+	 *@par Description:
+	 *  The neighbors of query <em>q</em> are set in
+	 *  <em>neighs[k * q]</em> to <em>neighs[k * q + k - 1]</em>, padded
+	 *  with <em>-1</em> when there are fewer than <em>k</em> points.
+	 *  Query <em>q</em> leaves out point <em>excludes[q]</em>, if
+	 *  <em>excludes</em> is not NULL.
+	 */
+	void GetKNearest(const int nrQueries,
+			 const double queries[],
+			 const int k,
+			 std::vector<int> * const neighs,
+			 std::vector<double> * const dists = NULL,
+			 const int excludes[] = NULL,
+			 const int nrThreads = 0) const;
+
+	/**
+	 *@brief Run <em>GetNeighsInRadius</em> for the points
+	 *       <em>queries[2 * q], queries[2 * q + 1]</em> on
+	 *       <em>nrThreads</em> threads
+	 *
+	 *@par Description:
+	 *  As for the edges of <em>CSRGraph</em>, the neighbors of query
+	 *  <em>q</em> are <em>neighs[starts[q]]</em> to
+	 *  <em>neighs[starts[q + 1] - 1]</em>.
+	 */
+	void GetNeighsInRadius(const int nrQueries,
+			       const double queries[],
+			       const double r,
+			       std::vector<int> * const starts,
+			       std::vector<int> * const neighs,
+			       const int excludes[] = NULL,
+			       const int nrThreads = 0) const;
+
+    protected:
+	struct Node
+	{
+	    double m_split;
+	    int    m_axis;
+
+	    /**
+	     *@brief Left child, followed by the right child, or -1 for
+	     *       a leaf
+	     */
+	    int    m_child;
+	    int    m_count;
+	};
+
+	typedef std::priority_queue< std::pair<double, int> > KNearestQueue;
+
+	double DistSquared(const double p[2], const int id) const
+	{
+	    const double dx = p[0] - m_points[2 * id];
+	    const double dy = p[1] - m_points[2 * id + 1];
+
+	    return dx * dx + dy * dy;
+	}
+
+	/**
+	 *@brief Rebuild the whole tree over <em>m_points</em>
+	 */
+	void Rebuild(void);
+
+	/**
+	 *@brief Make <em>node</em> the root of a balanced subtree over
+	 *       the points in <em>ids</em>, which are reordered
+	 */
+	void BuildNode(const int node, int ids[], const int n);
+
+	/**
+	 *@brief Append the ids of the points under <em>node</em>, whose
+	 *       descendants are then no longer used
+	 */
+	void CollectIds(const int node, std::vector<int> * const ids);
+
+	void KNearest(const int node, const double p[2], const int k, const int exclude,
+		      KNearestQueue * const best) const;
+
+	void NeighsInRadius(const int node, const double p[2], const double rr, const int exclude,
+			    std::vector<int> * const neighs) const;
+
+	std::vector<double>            m_points;
+	std::vector<Node>              m_nodes;
+	std::vector<std::vector<int> > m_buckets;
+	int                            m_nrGarbage;
+    };
+}
+
+#endif
@@ -0,0 +1,118 @@
+#include "Utils/LandmarkSearchInfo.hpp"
+
+namespace Abetare
+{
+    void LandmarkSearchInfo::ComputeCosts(const int source, const bool forward, std::vector<double> * const costs)
+    {
+	std::vector<int>    edges;
+	std::vector<double> ecosts;
+
+	costs->assign(costs->size(), HUGE_VAL);
+	m_heap.Clear();
+	(*costs)[source] = 0;
+	m_heap.Insert(source, 0);
+
+	while(!m_heap.IsEmpty())
+	{
+	    const int    u  = m_heap.RemoveTop();
+	    const double cu = (*costs)[u];
+
+	    edges.clear();
+	    ecosts.clear();
+	    if(forward)
+		m_base->GetOutEdges(u, &edges, &ecosts);
+	    else
+		m_base->GetInEdges(u, &edges, &ecosts);
+
+	    const int n = edges.size();
+	    for(int i = 0; i < n; ++i)
+	    {
+		const int    v  = edges[i];
+		const double cv = cu + ecosts[i];
+
+		if(cv < (*costs)[v])
+		{
+		    (*costs)[v] = cv;
+		    m_heap.InsertOrUpdate(v, cv);
+		}
+	    }
+	}
+    }
+
+    void LandmarkSearchInfo::Setup(const int nrKeys, const int nrLandmarks, const int seed)
+    {
+	std::vector<double> from(nrKeys);
+	std::vector<double> to(nrKeys);
+	std::vector<double> mins(nrKeys);
+
+	m_heap.Setup(nrKeys);
+	m_landmarks.clear();
+
+	//the first landmark is the key farthest from the seed
+	ComputeCosts(seed, false, &mins);
+
+	for(int i = 0; i < nrLandmarks; ++i)
+	{
+	    int    best  = Constants::ID_UNDEFINED;
+	    double dbest = 0;
+
+	    for(int u = 0; u < nrKeys; ++u)
+		if(mins[u] != HUGE_VAL && mins[u] > dbest)
+		{
+		    best  = u;
+		    dbest = mins[u];
+		}
+	    if(best == Constants::ID_UNDEFINED)
+		break;
+	    m_landmarks.push_back(best);
+
+	    ComputeCosts(best, false, &to);
+	    for(int u = 0; u < nrKeys; ++u)
+		if(to[u] < mins[u])
+		    mins[u] = to[u];
+	}
+
+	const int nl = m_landmarks.size();
+
+	m_costsFrom.resize(nrKeys * nl);
+	m_costsTo.resize(nrKeys * nl);
+	for(int i = 0; i < nl; ++i)
+	{
+	    ComputeCosts(m_landmarks[i], true, &from);
+	    ComputeCosts(m_landmarks[i], false, &to);
+	    for(int u = 0; u < nrKeys; ++u)
+	    {
+		m_costsFrom[u * nl + i] = from[u];
+		m_costsTo[u * nl + i]   = to[u];
+	    }
+	}
+    }
+
+    double LandmarkSearchInfo::LandmarkDistance(const int u, const int v) const
+    {
+	const int nl = m_landmarks.size();
+
+	if(nl == 0)
+	    return 0;
+
+	const double *fromU = &m_costsFrom[u * nl];
+	const double *fromV = &m_costsFrom[v * nl];
+	const double *toU   = &m_costsTo[u * nl];
+	const double *toV   = &m_costsTo[v * nl];
+	double        d     = 0;
+
+	//comparisons are false for NaN, i.e., when both costs are infinite
+	for(int i = 0; i < nl; ++i)
+	{
+	    const double d1 = fromV[i] - fromU[i];
+	    const double d2 = toU[i] - toV[i];
+
+	    if(d1 > d)
+		d = d1;
+	    if(d2 > d)
+		d = d2;
+	}
+
+	return d;
+    }
+}
@@ -0,0 +1,148 @@
+#ifndef ABETARE__LANDMARK_SEARCH_INFO_HPP_
+#define ABETARE__LANDMARK_SEARCH_INFO_HPP_
+
+#include "Utils/GraphSearch.hpp"
+#include "Utils/DaryHeap.hpp"
+#include "Utils/Constants.hpp"
+#include <vector>
+#include <cmath>
+
+namespace Abetare
+{
+    /**
+     *@brief ALT heuristics (A*, landmarks, triangle inequality) over
+     *       dense integer keys
+     *
+     *@par Description:
+     *  Wraps another search info, whose edges and heuristics are kept,
+     *  and adds lower bounds from precomputed shortest-path costs to and
+     *  from a few landmarks. For a landmark <em>L</em>, the triangle
+     *  inequality gives
+     *  <em>d(u, t) >= max(d(L, t) - d(L, u), d(u, L) - d(t, L))</em>.
+     *  The heuristic is the maximum over the landmarks and the wrapped
+     *  heuristic, which stays consistent. Landmarks are chosen by
+     *  farthest-point selection, so they end up at the periphery of
+     *  the graph, behind the obstacles that make the wrapped heuristic
+     *  weak. The tables are computed once and serve any number of
+     *  queries as long as the edge costs do not decrease.
+     */
+    class LandmarkSearchInfo : public GraphSearchInfo<int>
+    {
+    public:
+	LandmarkSearchInfo(void) : GraphSearchInfo<int>()
+	{
+	    m_base  = NULL;
+	    m_start = Constants::ID_UNDEFINED;
+	    m_goal  = Constants::ID_UNDEFINED;
+	}
+
+	virtual ~LandmarkSearchInfo(void)
+	{
+	}
+
+	GraphSearchInfo<int> *m_base;
+
+	/**
+	 *@brief Select <em>nrLandmarks</em> landmarks among the keys in
+	 *       <em>[0, nrKeys)</em> and compute their cost tables
+	 *
+	 *@par Description:
+	 *  The first landmark is the key farthest from <em>seed</em>, and
+	 *  each next one the key farthest from the landmarks selected so
+	 *  far. Only keys connected to <em>seed</em> are considered.
+	 */
+	virtual void Setup(const int nrKeys, const int nrLandmarks, const int seed);
+
+	int GetNrLandmarks(void) const
+	{
+	    return m_landmarks.size();
+	}
+
+	int GetLandmark(const int i) const
+	{
+	    return m_landmarks[i];
+	}
+
+	void SetStart(const int start)
+	{
+	    m_start = start;
+	}
+
+	int GetStart(void) const
+	{
+	    return m_start;
+	}
+
+	void SetGoal(const int goal)
+	{
+	    m_goal = goal;
+	}
+
+	int GetGoal(void) const
+	{
+	    return m_goal;
+	}
+
+	/**
+	 *@brief Lower bound on the cost of a path from <em>u</em> to
+	 *       <em>v</em> given by the landmarks
+	 */
+	double LandmarkDistance(const int u, const int v) const;
+
+	virtual void GetOutEdges(const int u,
+				 std::vector<int> * const edges,
+				 std::vector<double> * const costs = NULL) const
+	{
+	    m_base->GetOutEdges(u, edges, costs);
+	}
+
+	virtual void GetInEdges(const int v,
+				std::vector<int> * const edges,
+				std::vector<double> * const costs = NULL) const
+	{
+	    m_base->GetInEdges(v, edges, costs);
+	}
+
+	virtual bool IsGoal(const int key) const
+	{
+	    return key == m_goal;
+	}
+
+	virtual double HeuristicCostToGoal(const int u) const
+	{
+	    const double h = m_base->HeuristicCostToGoal(u);
+	    const double l = LandmarkDistance(u, m_goal);
+
+	    return l > h ? l : h;
+	}
+
+	virtual double HeuristicCostFromStart(const int u) const
+	{
+	    const double h = m_base->HeuristicCostFromStart(u);
+	    const double l = LandmarkDistance(m_start, u);
+
+	    return l > h ? l : h;
+	}
+
+    protected:
+	/**
+	 *@brief Dijkstra from <em>source</em> over the out edges
+	 *       (<em>forward</em>) or the in edges
+	 */
+	void ComputeCosts(const int source, const bool forward, std::vector<double> * const costs);
+
+	std::vector<int>    m_landmarks;
+
+	/**
+	 *@brief Costs from and to the landmarks, stored by key so that
+	 *       evaluating the heuristic reads contiguous memory
+	 */
+	std::vector<double> m_costsFrom;
+	std::vector<double> m_costsTo;
+	DaryHeap<4>         m_heap;
+	int                 m_start;
+	int                 m_goal;
+    };
+}
+
+#endif
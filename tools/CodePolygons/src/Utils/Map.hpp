@@ -0,0 +1,303 @@
+#ifndef ABETARE__MAP_HPP_
+#define ABETARE__MAP_HPP_
+
+#include <vector>
+#include <cstdlib>
+
+namespace Abetare
+{
+    /**
+     *@brief Hash function used by <em>MapDefault</em>
+     *
+     *@par Description:
+     *  The default hashes the bytes of the key, which is suitable for
+     *  plain structs without padding. Keys with padding or with
+     *  pointers to data should specialize this template.
+     */
+    template <typename Key>
+    struct MapHash
+    {
+	static unsigned long long Hash(const Key & key)
+	{
+	    const unsigned char *bytes = (const unsigned char *) &key;
+	    unsigned long long   h     = 14695981039346656037ULL;
+
+	    for(int i = 0; i < (int) sizeof(Key); ++i)
+		h = (h ^ bytes[i]) * 1099511628211ULL;
+	    return Mix(h);
+	}
+
+	static unsigned long long Mix(unsigned long long h)
+	{
+	    h ^= h >> 33;
+	    h *= 0xff51afd7ed558ccdULL;
+	    h ^= h >> 33;
+	    h *= 0xc4ceb9fe1a85ec53ULL;
+	    h ^= h >> 33;
+	    return h;
+	}
+    };
+
+#define ABETARE__MAP_HASH_INTEGER(Type)					\
+    template <>								\
+    struct MapHash<Type>						\
+    {									\
+	static unsigned long long Hash(const Type & key)		\
+	{								\
+	    return MapHash<char>::Mix((unsigned long long) key);	\
+	}								\
+    };
+
+    ABETARE__MAP_HASH_INTEGER(int)
+    ABETARE__MAP_HASH_INTEGER(unsigned int)
+    ABETARE__MAP_HASH_INTEGER(long)
+    ABETARE__MAP_HASH_INTEGER(unsigned long)
+    ABETARE__MAP_HASH_INTEGER(long long)
+    ABETARE__MAP_HASH_INTEGER(unsigned long long)
+    ABETARE__MAP_HASH_INTEGER(short)
+    ABETARE__MAP_HASH_INTEGER(unsigned short)
+
+#undef ABETARE__MAP_HASH_INTEGER
+
+    /**
+     *@brief Hash map from <em>Key</em> to <em>Data</em> with open
+     *       addressing
+     *
+     *@par Description:
+     *  Entries are stored inline in a single power-of-two array and
+     *  collisions are resolved by linear probing with Robin Hood
+     *  displacement, which keeps probe sequences short and lookups
+     *  cache friendly. Removal shifts the following entries back, so
+     *  there are no tombstones.
+     *  \n\n
+     *  Each slot records the generation in which it was written and
+     *  only slots from the current generation are occupied. Hence,
+     *  <em>Clear</em> runs in constant time, which matters when the
+     *  same map is reused across many searches.
+     *  \n\n
+     *  <em>Key</em> must support <em>operator==</em>. Both
+     *  <em>Key</em> and <em>Data</em> must be default constructible and
+     *  assignable.
+     */
+    template <typename Key, typename Data, typename Hash = MapHash<Key> >
+    class MapDefault
+    {
+    public:
+	MapDefault(void)
+	{
+	    m_gen  = 1;
+	    m_size = 0;
+	    Allocate(16);
+	}
+
+	virtual ~MapDefault(void)
+	{
+	}
+
+	int GetNrKeys(void) const
+	{
+	    return m_size;
+	}
+
+	bool IsEmpty(void) const
+	{
+	    return m_size == 0;
+	}
+
+	bool HasKey(const Key key) const
+	{
+	    return Find(key) >= 0;
+	}
+
+	/**
+	 *@brief Get the data associated with the key, which must be in the map
+	 */
+	const Data& GetData(const Key key) const
+	{
+	    return m_slots[Find(key)].m_data;
+	}
+
+	/**
+	 *@brief Get the data associated with the key or
+	 *       <em>defaultData</em> if the key is not in the map
+	 */
+	Data GetData(const Key key, const Data & defaultData, bool * const hadKey) const
+	{
+	    const int pos = Find(key);
+
+	    *hadKey = pos >= 0;
+	    return pos >= 0 ? m_slots[pos].m_data : defaultData;
+	}
+
+	/**
+	 *@brief Get a pointer to the data associated with the key or NULL
+	 *       if the key is not in the map
+	 *
+	 *@par Description:
+	 *  Inserting a new key or removing a key may move other entries,
+	 *  which invalidates the pointer.
+	 */
+	Data* GetDataPointer(const Key key)
+	{
+	    const int pos = Find(key);
+	    return pos >= 0 ? &(m_slots[pos].m_data) : NULL;
+	}
+
+	const Data* GetDataPointer(const Key key) const
+	{
+	    const int pos = Find(key);
+	    return pos >= 0 ? &(m_slots[pos].m_data) : NULL;
+	}
+
+	/**
+	 *@brief Associate <em>data</em> with the key, replacing any
+	 *       previous association
+	 */
+	void Insert(const Key key, const Data & data)
+	{
+	    const int pos = Find(key);
+
+	    if(pos >= 0)
+		m_slots[pos].m_data = data;
+	    else
+		InsertNew(key, data);
+	}
+
+	void Update(const Key key, const Data & data)
+	{
+	    Insert(key, data);
+	}
+
+	bool Remove(const Key key)
+	{
+	    int pos = Find(key);
+
+	    if(pos < 0)
+		return false;
+
+	    //backward shift deletion
+	    for(int next = (pos + 1) & m_mask;
+		m_slots[next].m_gen == m_gen && m_slots[next].m_dist > 0;
+		pos = next, next = (next + 1) & m_mask)
+	    {
+		m_slots[pos] = m_slots[next];
+		--(m_slots[pos].m_dist);
+	    }
+	    m_slots[pos].m_gen = 0;
+	    --m_size;
+
+	    return true;
+	}
+
+	void Clear(void)
+	{
+	    m_size = 0;
+	    if(++m_gen == 0)
+	    {
+		//generation counter wrapped around: reset all slots
+		const int n = m_slots.size();
+		for(int i = 0; i < n; ++i)
+		    m_slots[i].m_gen = 0;
+		m_gen = 1;
+	    }
+	}
+
+	void GetKeys(std::vector<Key> * const keys) const
+	{
+	    const int n = m_slots.size();
+	    for(int i = 0; i < n; ++i)
+		if(m_slots[i].m_gen == m_gen)
+		    keys->push_back(m_slots[i].m_key);
+	}
+
+    protected:
+	struct Slot
+	{
+	    Key          m_key;
+	    Data         m_data;
+	    unsigned int m_gen;
+	    int          m_dist;
+	};
+
+	void Allocate(const int capacity)
+	{
+	    m_slots.clear();
+	    m_slots.resize(capacity);
+	    for(int i = 0; i < capacity; ++i)
+		m_slots[i].m_gen = 0;
+	    m_mask = capacity - 1;
+	    m_gen  = 1;
+	    m_size = 0;
+	}
+
+	int Find(const Key & key) const
+	{
+	    int pos = (int) (Hash::Hash(key) & m_mask);
+
+	    for(int dist = 0; ; ++dist, pos = (pos + 1) & m_mask)
+	    {
+		const Slot *slot = &(m_slots[pos]);
+
+		//an entry is never further from its home than the one being searched
+		if(slot->m_gen != m_gen || slot->m_dist < dist)
+		    return -1;
+		if(slot->m_key == key)
+		    return pos;
+	    }
+	}
+
+	void InsertNew(const Key key, const Data & data)
+	{
+	    //keep the load factor below 7/8
+	    if(8 * (m_size + 1) > 7 * (int) m_slots.size())
+		Grow();
+
+	    Slot carry;
+	    int  pos = (int) (Hash::Hash(key) & m_mask);
+
+	    carry.m_key  = key;
+	    carry.m_data = data;
+	    carry.m_gen  = m_gen;
+	    carry.m_dist = 0;
+
+	    for(;; pos = (pos + 1) & m_mask, ++(carry.m_dist))
+	    {
+		Slot *slot = &(m_slots[pos]);
+
+		if(slot->m_gen != m_gen)
+		{
+		    *slot = carry;
+		    break;
+		}
+		if(slot->m_dist < carry.m_dist)
+		{
+		    const Slot tmp = *slot;
+		    *slot = carry;
+		    carry = tmp;
+		}
+	    }
+	    ++m_size;
+	}
+
+	void Grow(void)
+	{
+	    std::vector<Slot>  old;
+	    const unsigned int gen = m_gen;
+
+	    old.swap(m_slots);
+	    Allocate(2 * old.size());
+
+	    const int n = old.size();
+	    for(int i = 0; i < n; ++i)
+		if(old[i].m_gen == gen)
+		    InsertNew(old[i].m_key, old[i].m_data);
+	}
+
+	std::vector<Slot> m_slots;
+	int               m_mask;
+	int               m_size;
+	unsigned int      m_gen;
+    };
+}
+
+#endif
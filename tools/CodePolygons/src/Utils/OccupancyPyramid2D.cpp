@@ -0,0 +1,273 @@
+#include "Utils/OccupancyPyramid2D.hpp"
+#include <cmath>
+
+namespace Abetare
+{
+    static bool SegmentTouchesAABox2D(const double p1[2],
+				      const double p2[2],
+				      const double min[2],
+				      const double max[2])
+    {
+	double tmin = 0;
+	double tmax = 1;
+
+	for(int i = 0; i < 2; ++i)
+	{
+	    const double d = p2[i] - p1[i];
+
+	    if(d == 0)
+	    {
+		if(p1[i] < min[i] || p1[i] > max[i])
+		    return false;
+	    }
+	    else
+	    {
+		double t1 = (min[i] - p1[i]) / d;
+		double t2 = (max[i] - p1[i]) / d;
+
+		if(t1 > t2)
+		{
+		    const double t = t1; t1 = t2; t2 = t;
+		}
+		if(t1 > tmin)
+		    tmin = t1;
+		if(t2 < tmax)
+		    tmax = t2;
+		if(tmin > tmax)
+		    return false;
+	    }
+	}
+	return true;
+    }
+
+    void OccupancyPyramid2D::Build(const Grid * const grid, const bool occupied[])
+    {
+	const int *dims = grid->GetDims();
+
+	m_grid = grid;
+	m_dims.clear();
+	m_levels.clear();
+
+	m_dims.push_back(dims[0]);
+	m_dims.push_back(dims[1]);
+	m_levels.resize(1);
+	m_levels[0].resize(dims[0] * dims[1]);
+	for(int i = dims[0] * dims[1] - 1; i >= 0; --i)
+	    m_levels[0][i] = occupied[i] ? (FLAG_ANY_OCCUPIED | FLAG_ALL_OCCUPIED) : 0;
+
+	for(int l = 0; m_dims[2 * l] > 1 || m_dims[2 * l + 1] > 1; ++l)
+	{
+	    const int cx = m_dims[2 * l];
+	    const int cy = m_dims[2 * l + 1];
+	    const int nx = (cx + 1) / 2;
+	    const int ny = (cy + 1) / 2;
+
+	    m_dims.push_back(nx);
+	    m_dims.push_back(ny);
+	    m_levels.resize(l + 2);
+	    m_levels[l + 1].resize(nx * ny);
+
+	    const std::vector<unsigned char> *fine   = &(m_levels[l]);
+	    std::vector<unsigned char>       *coarse = &(m_levels[l + 1]);
+
+	    for(int y = 0; y < ny; ++y)
+		for(int x = 0; x < nx; ++x)
+		{
+		    unsigned char any = 0;
+		    unsigned char all = FLAG_ALL_OCCUPIED;
+
+		    for(int j = 2 * y; j <= 2 * y + 1 && j < cy; ++j)
+			for(int i = 2 * x; i <= 2 * x + 1 && i < cx; ++i)
+			{
+			    any |= (*fine)[j * cx + i] & FLAG_ANY_OCCUPIED;
+			    all &= (*fine)[j * cx + i];
+			}
+		    (*coarse)[y * nx + x] = any | all;
+		}
+	}
+    }
+
+    void OccupancyPyramid2D::GetCellBox(const int level,
+					const int x,
+					const int y,
+					double    min[2],
+					double    max[2]) const
+    {
+	const double *gmin  = m_grid->GetMin();
+	const double *units = m_grid->GetUnits();
+	const int     xmax  = (x + 1) << level;
+	const int     ymax  = (y + 1) << level;
+
+	min[0] = gmin[0] + units[0] * (x << level);
+	min[1] = gmin[1] + units[1] * (y << level);
+	max[0] = gmin[0] + units[0] * (xmax < m_dims[0] ? xmax : m_dims[0]);
+	max[1] = gmin[1] + units[1] * (ymax < m_dims[1] ? ymax : m_dims[1]);
+    }
+
+    void OccupancyPyramid2D::ClassifyRange(const int level,
+					   const int x,
+					   const int y,
+					   const int range[4],
+					   const bool stopAtOccupied,
+					   bool * const seenFree,
+					   bool * const seenOccupied,
+					   int  * const finest) const
+    {
+	if((*seenFree && *seenOccupied) || (stopAtOccupied && *seenOccupied))
+	    return;
+
+	const int x0 = x << level;
+	const int y0 = y << level;
+	const int x1 = ((x + 1) << level) - 1;
+	const int y1 = ((y + 1) << level) - 1;
+
+	if(x0 > range[2] || x1 < range[0] || y0 > range[3] || y1 < range[1])
+	    return;
+
+	if(level < *finest)
+	    *finest = level;
+
+	const unsigned char flags = GetFlags(level, x, y);
+
+	if(!(flags & FLAG_ANY_OCCUPIED))
+	    *seenFree = true;
+	else if(flags & FLAG_ALL_OCCUPIED)
+	    *seenOccupied = true;
+	else if(x0 >= range[0] && x1 <= range[2] && y0 >= range[1] && y1 <= range[3])
+	    *seenFree = *seenOccupied = true;
+	else
+	{
+	    const int *dims = GetLevelDims(level - 1);
+
+	    for(int j = 2 * y; j <= 2 * y + 1 && j < dims[1]; ++j)
+		for(int i = 2 * x; i <= 2 * x + 1 && i < dims[0]; ++i)
+		    ClassifyRange(level - 1, i, j, range, stopAtOccupied, seenFree, seenOccupied, finest);
+	}
+    }
+
+    void OccupancyPyramid2D::ClassifyBox(const double min[2],
+					 const double max[2],
+					 const bool   stopAtOccupied,
+					 bool * const seenFree,
+					 bool * const seenOccupied,
+					 int  * const level) const
+    {
+	const double *gmin   = m_grid->GetMin();
+	const double *gmax   = m_grid->GetMax();
+	int           finest = m_levels.size() - 1;
+	int           range[4];
+	int           l      = 0;
+
+	*seenFree     = false;
+	*seenOccupied = false;
+	if(max[0] < gmin[0] || min[0] > gmax[0] || max[1] < gmin[1] || min[1] > gmax[1])
+	{
+	    *seenFree = true;
+	    if(level)
+		*level = finest;
+	    return;
+	}
+
+	m_grid->GetCoords(min, &range[0]);
+	m_grid->GetCoords(max, &range[2]);
+
+	//coarsest level at which the range spans at most 2x2 cells
+	while(((range[2] >> l) - (range[0] >> l)) > 1 || ((range[3] >> l) - (range[1] >> l)) > 1)
+	    ++l;
+
+	for(int y = range[1] >> l; y <= (range[3] >> l); ++y)
+	    for(int x = range[0] >> l; x <= (range[2] >> l); ++x)
+		ClassifyRange(l, x, y, range, stopAtOccupied, seenFree, seenOccupied, &finest);
+
+	if(level)
+	    *level = finest;
+    }
+
+    int OccupancyPyramid2D::ClassifyBox(const double min[2], const double max[2], int * const level) const
+    {
+	bool seenFree, seenOccupied;
+
+	ClassifyBox(min, max, false, &seenFree, &seenOccupied, level);
+	return seenOccupied ? (seenFree ? STATUS_MIXED : STATUS_OCCUPIED) : STATUS_FREE;
+    }
+
+    bool OccupancyPyramid2D::IsBoxFree(const double min[2], const double max[2], int * const level) const
+    {
+	bool seenFree, seenOccupied;
+
+	ClassifyBox(min, max, true, &seenFree, &seenOccupied, level);
+	return !seenOccupied;
+    }
+
+    bool OccupancyPyramid2D::IsSegmentFree(const int level,
+					   const int x,
+					   const int y,
+					   const double p1[2],
+					   const double p2[2],
+					   int  * const finest) const
+    {
+	double min[2], max[2];
+
+	GetCellBox(level, x, y, min, max);
+	if(!SegmentTouchesAABox2D(p1, p2, min, max))
+	    return true;
+
+	if(level < *finest)
+	    *finest = level;
+
+	const unsigned char flags = GetFlags(level, x, y);
+
+	if(!(flags & FLAG_ANY_OCCUPIED))
+	    return true;
+	if(flags & FLAG_ALL_OCCUPIED)
+	    return false;
+
+	const int *dims = GetLevelDims(level - 1);
+
+	for(int j = 2 * y; j <= 2 * y + 1 && j < dims[1]; ++j)
+	    for(int i = 2 * x; i <= 2 * x + 1 && i < dims[0]; ++i)
+		if(!IsSegmentFree(level - 1, i, j, p1, p2, finest))
+		    return false;
+	return true;
+    }
+
+    bool OccupancyPyramid2D::IsSegmentFree(const double p1[2], const double p2[2], int * const level) const
+    {
+	const double min[2] =
+	    {
+		p1[0] < p2[0] ? p1[0] : p2[0],
+		p1[1] < p2[1] ? p1[1] : p2[1]
+	    };
+	const double max[2] =
+	    {
+		p1[0] > p2[0] ? p1[0] : p2[0],
+		p1[1] > p2[1] ? p1[1] : p2[1]
+	    };
+	const double *gmin   = m_grid->GetMin();
+	const double *gmax   = m_grid->GetMax();
+	int           finest = m_levels.size() - 1;
+	int           range[4];
+	int           l      = 0;
+	bool          isFree = true;
+
+	if(level)
+	    *level = finest;
+	if(max[0] < gmin[0] || min[0] > gmax[0] || max[1] < gmin[1] || min[1] > gmax[1])
+	    return true;
+
+	m_grid->GetCoords(min, &range[0]);
+	m_grid->GetCoords(max, &range[2]);
+
+	while(((range[2] >> l) - (range[0] >> l)) > 1 || ((range[3] >> l) - (range[1] >> l)) > 1)
+	    ++l;
+
+	for(int y = range[1] >> l; y <= (range[3] >> l) && isFree; ++y)
+	    for(int x = range[0] >> l; x <= (range[2] >> l) && isFree; ++x)
+		isFree = IsSegmentFree(l, x, y, p1, p2, &finest);
+
+	if(level)
+	    *level = finest;
+
+	return isFree;
+    }
+}
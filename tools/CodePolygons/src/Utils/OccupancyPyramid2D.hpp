@@ -0,0 +1,125 @@
+#ifndef ABETARE__OCCUPANCY_PYRAMID2D_HPP_
+#define ABETARE__OCCUPANCY_PYRAMID2D_HPP_
+
+#include "Utils/Grid.hpp"
+#include <vector>
+#include <cstdlib>
+
+namespace Abetare
+{
+    /**
+     *@brief Multi-resolution pyramid over the occupancy of a 2D grid
+     *
+     *@par Description:
+     *  Level 0 is the occupancy of the grid cells. Each cell at level
+     *  <em>l + 1</em> covers up to 2x2 cells of level <em>l</em> and
+     *  records whether any or all of the covered cells are
+     *  occupied. Box and segment queries start at the coarsest level
+     *  and descend only into cells that are partially occupied, so
+     *  queries over free or fully blocked regions are resolved after
+     *  a few cells. Building the pyramid is linear in the number of
+     *  grid cells.
+     */
+    class OccupancyPyramid2D
+    {
+    public:
+	OccupancyPyramid2D(void)
+	{
+	    m_grid = NULL;
+	}
+
+	virtual ~OccupancyPyramid2D(void)
+	{
+	}
+
+	enum Flags
+	    {
+		FLAG_ANY_OCCUPIED = 1,
+		FLAG_ALL_OCCUPIED = 2
+	    };
+
+	enum Status
+	    {
+		STATUS_FREE     = 0,
+		STATUS_OCCUPIED = 1,
+		STATUS_MIXED    = 2
+	    };
+
+	/**
+	 *@brief Build the pyramid
+	 *
+	 *@param grid     2D grid (must outlive the pyramid)
+	 *@param occupied occupancy of each grid cell, indexed by cell id
+	 */
+	virtual void Build(const Grid * const grid, const bool occupied[]);
+
+	int GetNrLevels(void) const
+	{
+	    return m_levels.size();
+	}
+
+	const int* GetLevelDims(const int level) const
+	{
+	    return &(m_dims[2 * level]);
+	}
+
+	unsigned char GetFlags(const int level, const int x, const int y) const
+	{
+	    return m_levels[level][y * m_dims[2 * level] + x];
+	}
+
+	/**
+	 *@brief Classify the grid cells overlapped by the box
+	 *
+	 *@param level if not NULL, set to the finest level that had to be
+	 *             visited to resolve the query
+	 */
+	int ClassifyBox(const double min[2], const double max[2], int * const level = NULL) const;
+
+	bool IsBoxFree(const double min[2], const double max[2], int * const level = NULL) const;
+
+	/**
+	 *@brief Determine whether the segment crosses only free grid cells
+	 *
+	 *@param level if not NULL, set to the finest level that had to be
+	 *             visited to resolve the query
+	 */
+	bool IsSegmentFree(const double p1[2], const double p2[2], int * const level = NULL) const;
+
+    protected:
+	void ClassifyBox(const double min[2],
+			 const double max[2],
+			 const bool   stopAtOccupied,
+			 bool * const seenFree,
+			 bool * const seenOccupied,
+			 int  * const level) const;
+
+	void ClassifyRange(const int level,
+			   const int x,
+			   const int y,
+			   const int range[4],
+			   const bool stopAtOccupied,
+			   bool * const seenFree,
+			   bool * const seenOccupied,
+			   int  * const finest) const;
+
+	bool IsSegmentFree(const int level,
+			   const int x,
+			   const int y,
+			   const double p1[2],
+			   const double p2[2],
+			   int  * const finest) const;
+
+	void GetCellBox(const int level,
+			const int x,
+			const int y,
+			double    min[2],
+			double    max[2]) const;
+
+	const Grid                               *m_grid;
+	std::vector<int>                          m_dims;
+	std::vector< std::vector<unsigned char> > m_levels;
+    };
+}
+
+#endif
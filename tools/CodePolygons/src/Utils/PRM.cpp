@@ -0,0 +1,276 @@
+#include "Utils/PRM.hpp"
+#include "Utils/PRMSamplers.hpp"
+#include "Utils/Parallel.hpp"
+#include "Utils/Geometry.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace Abetare
+{
+    //samples of a block share one random stream, so the blocks fix the result
+    static const int PRM_SAMPLES_PER_BLOCK = 64;
+
+    //give up on a sample after this many points in collision
+    static const int PRM_MAX_SAMPLE_ATTEMPTS = 10000;
+
+    void PRM::Setup(const int nrObstacles, Polygon2D * const obstacles[], const double bbox[4])
+    {
+	m_obstacles.assign(obstacles, obstacles + nrObstacles);
+	m_convex.resize(nrObstacles);
+	m_bboxes.resize(4 * nrObstacles);
+	for(int i = 0; i < nrObstacles; ++i)
+	{
+	    const double *obox = obstacles[i]->GetBoundingBox();
+
+	    m_convex[i] = obstacles[i]->IsConvex();
+	    for(int j = 0; j < 4; ++j)
+		m_bboxes[4 * i + j] = obox[j];
+	}
+	for(int j = 0; j < 4; ++j)
+	    m_bbox[j] = bbox[j];
+    }
+
+    bool PRM::IsPointValid(const double p[2]) const
+    {
+	if(p[0] < m_bbox[0] || p[0] > m_bbox[2] || p[1] < m_bbox[1] || p[1] > m_bbox[3])
+	    return false;
+
+	for(int i = 0; i < (int) m_obstacles.size(); ++i)
+	{
+	    const double *obox = &(m_bboxes[4 * i]);
+
+	    if(p[0] < obox[0] || p[0] > obox[2] || p[1] < obox[1] || p[1] > obox[3])
+		continue;
+
+	    const std::vector<double> & poly = m_obstacles[i]->m_vertices;
+
+	    if(m_convex[i] ?
+	       IsPointInsideConvexPolygon2D(p, poly.size() / 2, &poly[0]) :
+	       IsPointInsidePolygon2D(p, poly.size() / 2, &poly[0]))
+		return false;
+	}
+
+	return true;
+    }
+
+    bool PRM::IsSegmentValid(const double p0[2], const double p1[2]) const
+    {
+	const double smin[2] = {p0[0] < p1[0] ? p0[0] : p1[0], p0[1] < p1[1] ? p0[1] : p1[1]};
+	const double smax[2] = {p0[0] < p1[0] ? p1[0] : p0[0], p0[1] < p1[1] ? p1[1] : p0[1]};
+
+	for(int i = 0; i < (int) m_obstacles.size(); ++i)
+	{
+	    if(!CollisionAABoxes2D(smin, smax, &(m_bboxes[4 * i]), &(m_bboxes[4 * i + 2])))
+		continue;
+
+	    const std::vector<double> & poly = m_obstacles[i]->m_vertices;
+
+	    if(m_convex[i] ?
+	       CollisionSegmentConvexPolygon2D(p0, p1, poly.size() / 2, &poly[0]) :
+	       CollisionSegmentPolygon2D(p0, p1, poly.size() / 2, &poly[0]))
+		return false;
+	}
+
+	return true;
+    }
+
+    void PRM::SamplePoint(const int i, RandomStream * const rng, double p[2]) const
+    {
+	//a sampler can fail without setting p, e.g., near obstacles when
+	//there are none, so fall back to uniform sampling
+	if(m_sampler && m_sampler->SamplePoint(*this, i, rng, p))
+	    return;
+
+	for(int k = 0; k < PRM_MAX_SAMPLE_ATTEMPTS; ++k)
+	{
+	    p[0] = rng->UniformReal(m_bbox[0], m_bbox[2]);
+	    p[1] = rng->UniformReal(m_bbox[1], m_bbox[3]);
+	    if(IsPointValid(p))
+		return;
+	}
+    }
+
+    void PRM::GetCandidateEdges(std::vector<int> * const sources, std::vector<int> * const targets)
+    {
+	const int              n = GetNrVertices();
+	const int              k = m_nrNeighs;
+	std::vector<char>      valid(n);
+	std::vector<int>       ids(n);
+	std::vector<int>       neighs;
+	std::vector<long long> pairs;
+
+	for(int u = 0; u < n; ++u)
+	    ids[u] = u;
+	ParallelFor(n, m_nrThreads, [&](const int u, const int t)
+		    {
+			valid[u] = IsPointValid(GetVertex(u));
+		    }, 64);
+
+	m_tree.Build(n, m_points.data());
+	m_tree.GetKNearest(n, m_points.data(), k, &neighs, NULL, ids.data(), m_nrThreads);
+
+	for(int u = 0; u < n; ++u)
+	    for(int i = 0; i < k && valid[u]; ++i)
+	    {
+		const int v = neighs[k * u + i];
+
+		if(v < 0 || !valid[v])
+		    continue;
+
+		const double *pu = GetVertex(u);
+		const double *pv = GetVertex(v);
+
+		if(m_maxDist == HUGE_VAL ||
+		   (pu[0] - pv[0]) * (pu[0] - pv[0]) + (pu[1] - pv[1]) * (pu[1] - pv[1]) <= m_maxDist * m_maxDist)
+		    pairs.push_back(u < v ? ((long long) u << 32) | v : ((long long) v << 32) | u);
+	    }
+
+	//an edge may be found from both ends
+	std::sort(pairs.begin(), pairs.end());
+	pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+	sources->resize(pairs.size());
+	targets->resize(pairs.size());
+	for(int i = 0; i < (int) pairs.size(); ++i)
+	{
+	    (*sources)[i] = (int) (pairs[i] >> 32);
+	    (*targets)[i] = (int) (pairs[i] & 0xFFFFFFFFLL);
+	}
+    }
+
+    void PRM::SetGraph(const std::vector<int> & sources, const std::vector<int> & targets,
+		       const std::vector<char> & valid)
+    {
+	std::vector<int>    esources, etargets;
+	std::vector<double> ecosts;
+
+	for(int i = 0; i < (int) sources.size(); ++i)
+	    if(valid[i])
+	    {
+		const double *pu = GetVertex(sources[i]);
+		const double *pv = GetVertex(targets[i]);
+		const double  d  = sqrt((pu[0] - pv[0]) * (pu[0] - pv[0]) + (pu[1] - pv[1]) * (pu[1] - pv[1]));
+
+		esources.push_back(sources[i]);
+		etargets.push_back(targets[i]);
+		ecosts.push_back(d);
+		esources.push_back(targets[i]);
+		etargets.push_back(sources[i]);
+		ecosts.push_back(d);
+	    }
+	m_graph.Setup(GetNrVertices(), esources.size(), esources.data(), etargets.data(), ecosts.data());
+	m_edgeStates.assign(m_graph.GetNrEdges(), m_lazy ? EDGE_UNKNOWN : EDGE_VALID);
+    }
+
+    void PRM::Build(const int nrSamples, const int nrFixed, const double fixed[])
+    {
+	const int nrBlocks = (nrSamples + PRM_SAMPLES_PER_BLOCK - 1) / PRM_SAMPLES_PER_BLOCK;
+
+	m_points.resize(2 * (nrFixed + nrSamples));
+	for(int i = 0; i < 2 * nrFixed; ++i)
+	    m_points[i] = fixed[i];
+	if(m_sampler)
+	    m_sampler->Setup(*this);
+
+	ParallelFor(nrBlocks, m_nrThreads, [&](const int b, const int t)
+		    {
+			RandomStream rng;
+			const int    end = std::min(nrSamples, (b + 1) * PRM_SAMPLES_PER_BLOCK);
+
+			rng.Seed(m_seed, b);
+			for(int i = b * PRM_SAMPLES_PER_BLOCK; i < end; ++i)
+			    SamplePoint(i, &rng, &(m_points[2 * (nrFixed + i)]));
+		    });
+
+	std::vector<int>  sources, targets;
+	std::vector<char> valid;
+
+	GetCandidateEdges(&sources, &targets);
+	if(m_lazy)
+	{
+	    valid.assign(sources.size(), 1);
+	    m_nrEdgeChecks = 0;
+	}
+	else
+	{
+	    valid.resize(sources.size());
+	    ParallelFor(sources.size(), m_nrThreads, [&](const int i, const int t)
+			{
+			    valid[i] = IsSegmentValid(GetVertex(sources[i]), GetVertex(targets[i]));
+			}, 64);
+	    m_nrEdgeChecks = sources.size();
+	}
+
+	SetGraph(sources, targets, valid);
+	m_search.Setup(GetNrVertices());
+    }
+
+    bool PRM::CheckEdge(const int u, const int v)
+    {
+	int e = m_graph.GetFirstEdge(u);
+	int r = m_graph.GetFirstEdge(v);
+
+	while(m_graph.GetEdgeTarget(e) != v)
+	    ++e;
+	while(m_graph.GetEdgeTarget(r) != u)
+	    ++r;
+
+	if(m_edgeStates[e] == EDGE_UNKNOWN)
+	{
+	    ++m_nrEdgeChecks;
+	    m_edgeStates[e] = m_edgeStates[r] = IsSegmentValid(GetVertex(u), GetVertex(v)) ? EDGE_VALID : EDGE_INVALID;
+	}
+
+	return m_edgeStates[e] == EDGE_VALID;
+    }
+
+    bool PRM::SearchPath(const int start, const int goal, std::vector<int> * const path)
+    {
+	std::vector<int> vertices;
+	int              found;
+
+	m_searchInfo.m_goal = goal;
+	for(bool valid = false; !valid;)
+	{
+	    if(!m_search.AStar(start, false, &found))
+		return false;
+
+	    vertices.clear();
+	    m_search.GetPathFromStart(found, &vertices);
+
+	    //edges in collision are removed by CheckEdge, so the next search
+	    //avoids them; checking the whole path saves searches
+	    valid = true;
+	    for(int i = 1; i < (int) vertices.size(); ++i)
+		if(!CheckEdge(vertices[i - 1], vertices[i]))
+		    valid = false;
+	}
+	path->insert(path->end(), vertices.begin(), vertices.end());
+
+	return true;
+    }
+
+    void PRMSearchInfo::GetOutEdges(const int u,
+				    std::vector<int> * const edges,
+				    std::vector<double> * const costs) const
+    {
+	const CSRGraph * const graph = m_prm->GetGraph();
+	const int              end   = graph->GetEndEdge(u);
+
+	for(int e = graph->GetFirstEdge(u); e < end; ++e)
+	    if(m_prm->IsEdgeUsable(e))
+	    {
+		edges->push_back(graph->GetEdgeTarget(e));
+		if(costs)
+		    costs->push_back(graph->GetEdgeCost(e));
+	    }
+    }
+
+    double PRMSearchInfo::HeuristicCostToGoal(const int u) const
+    {
+	const double *pu = m_prm->GetVertex(u);
+	const double *pg = m_prm->GetVertex(m_goal);
+
+	return sqrt((pu[0] - pg[0]) * (pu[0] - pg[0]) + (pu[1] - pg[1]) * (pu[1] - pg[1]));
+    }
+}
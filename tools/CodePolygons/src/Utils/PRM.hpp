@@ -0,0 +1,273 @@
+#ifndef ABETARE__PRM_HPP_
+#define ABETARE__PRM_HPP_
+
+#include "Utils/Polygon2D.hpp"
+#include "Utils/CSRGraph.hpp"
+#include "Utils/PseudoRandom.hpp"
+#include "Utils/KDTree2D.hpp"
+#include "Utils/DenseGraphSearch.hpp"
+#include <vector>
+#include <cmath>
+
+namespace Abetare
+{
+    class PRM;
+    class PRMSampler;
+
+    /**
+     *@brief Search over the edges of a roadmap that are not known to be
+     *       in collision, with Euclidean heuristics
+     */
+    class PRMSearchInfo : public GraphSearchInfo<int>
+    {
+    public:
+	PRMSearchInfo(void) : GraphSearchInfo<int>()
+	{
+	    m_prm  = NULL;
+	    m_goal = Constants::ID_UNDEFINED;
+	}
+
+	virtual ~PRMSearchInfo(void)
+	{
+	}
+
+	const PRM *m_prm;
+	int        m_goal;
+
+	virtual void GetOutEdges(const int u,
+				 std::vector<int> * const edges,
+				 std::vector<double> * const costs = NULL) const;
+
+	virtual bool IsGoal(const int key) const
+	{
+	    return key == m_goal;
+	}
+
+	virtual double HeuristicCostToGoal(const int u) const;
+    };
+
+    /**
+     *@brief Probabilistic roadmap among 2D polygonal obstacles
+     *
+     *@par Description:
+     *  Collision-free points are sampled by <em>m_sampler</em>, or
+     *  uniformly at random in the bounding box, each point is
+     *  connected to its <em>m_nrNeighs</em> nearest points, found with
+     *  a <em>KDTree2D</em>, and the straight edges that do not collide
+     *  with the obstacles are kept. The roadmap is a <em>CSRGraph</em>
+     *  with both directions of each edge and Euclidean costs, ready for
+     *  <em>CSRSearchInfo</em>.
+     *  \n\n
+     *  Sampling, neighbor queries and edge checks run on
+     *  <em>m_nrThreads</em> threads. Samples are generated in blocks of
+     *  fixed size, each with a <em>RandomStream</em> seeded by
+     *  <em>m_seed</em> and the block id, and edges are kept in a fixed
+     *  order, so the roadmap depends only on the seed and not on the
+     *  number of threads.
+     *  \n\n
+     *  The obstacles are read but not modified after <em>Setup</em>;
+     *  their convexity and bounding boxes are computed there, so that
+     *  the threads never trigger the lazy updates of <em>Polygon2D</em>.
+     *  \n\n
+     *  In lazy mode, the candidate edges are kept without being checked.
+     *  <em>SearchPath</em> then runs A* over the edges not known to be
+     *  in collision and checks every edge of the path it finds. If any
+     *  of them is in collision, all those found in collision are
+     *  removed and it searches again. Most candidate edges are never on
+     *  a path, so most checks are saved.
+     */
+    class PRM
+    {
+    public:
+	PRM(void)
+	{
+	    m_nrNeighs     = 10;
+	    m_maxDist      = HUGE_VAL;
+	    m_nrThreads    = 0;
+	    m_seed         = 0;
+	    m_lazy         = false;
+	    m_sampler      = NULL;
+	    m_nrEdgeChecks = 0;
+
+	    m_searchInfo.m_prm = this;
+	    m_search.m_info    = &m_searchInfo;
+	}
+
+	virtual ~PRM(void)
+	{
+	}
+
+	/**
+	 *@brief Number of nearest points each point is connected to
+	 */
+	int m_nrNeighs;
+
+	/**
+	 *@brief Longest edge, e.g., to limit connections in large maps
+	 */
+	double m_maxDist;
+
+	/**
+	 *@brief Number of threads; when not positive, the number of
+	 *       hardware threads is used
+	 */
+	int m_nrThreads;
+
+	unsigned long long m_seed;
+
+	/**
+	 *@brief Defer the edge checks to <em>SearchPath</em>
+	 */
+	bool m_lazy;
+
+	/**
+	 *@brief Sampling strategy, e.g., to put more points in narrow
+	 *       passages; points are uniform in the bounding box when NULL
+	 */
+	PRMSampler *m_sampler;
+
+	/**
+	 *@brief Set the obstacles, which must stay alive and unchanged
+	 *       while the roadmap is used, and the sampling region
+	 *       <em>[bbox[0], bbox[2]] x [bbox[1], bbox[3]]</em>
+	 */
+	virtual void Setup(const int nrObstacles, Polygon2D * const obstacles[], const double bbox[4]);
+
+	/**
+	 *@brief Build a roadmap over the <em>nrFixed</em> points in
+	 *       <em>fixed</em>, e.g., start and goal positions, which become
+	 *       its first vertices, and <em>nrSamples</em> random points
+	 *
+	 *@par Description:
+	 *  Fixed points that are in collision are kept as vertices but get
+	 *  no edges.
+	 */
+	virtual void Build(const int nrSamples, const int nrFixed = 0, const double fixed[] = NULL);
+
+	const double* GetBoundingBox(void) const
+	{
+	    return m_bbox;
+	}
+
+	int GetNrObstacles(void) const
+	{
+	    return m_obstacles.size();
+	}
+
+	const Polygon2D* GetObstacle(const int i) const
+	{
+	    return m_obstacles[i];
+	}
+
+	const CSRGraph* GetGraph(void) const
+	{
+	    return &m_graph;
+	}
+
+	int GetNrVertices(void) const
+	{
+	    return m_points.size() / 2;
+	}
+
+	const double* GetVertex(const int u) const
+	{
+	    return &(m_points[2 * u]);
+	}
+
+	/**
+	 *@brief Coordinates of the vertices, one after the other, as
+	 *       expected by <em>CSRSearchInfo::SetPoints</em>
+	 */
+	const double* GetPoints(void) const
+	{
+	    return m_points.data();
+	}
+
+	/**
+	 *@brief Find a collision-free path between vertices <em>start</em>
+	 *       and <em>goal</em> and add its vertices to <em>path</em>
+	 *
+	 *@par Description:
+	 *  In lazy mode, the edges found in collision are removed from the
+	 *  roadmap and those found free are remembered, so later searches
+	 *  check fewer edges.
+	 *
+	 *@returns false if there is no path
+	 */
+	bool SearchPath(const int start, const int goal, std::vector<int> * const path);
+
+	/**
+	 *@brief Returns true unless edge <em>e</em> of the graph is known
+	 *       to be in collision
+	 */
+	bool IsEdgeUsable(const int e) const
+	{
+	    return m_edgeStates[e] != EDGE_INVALID;
+	}
+
+	/**
+	 *@brief Number of edges checked for collision by the last build
+	 *       and the searches since then
+	 */
+	int GetNrEdgeChecks(void) const
+	{
+	    return m_nrEdgeChecks;
+	}
+
+	bool IsPointValid(const double p[2]) const;
+
+	bool IsSegmentValid(const double p0[2], const double p1[2]) const;
+
+    protected:
+	/**
+	 *@brief Sample collision-free point <em>i</em> with the generator
+	 *       of the current block, using <em>m_sampler</em> if set
+	 *
+	 *@par Description:
+	 *  Uniform sampling is used when there is no sampler or when it
+	 *  fails. If that fails too, <em>p</em> is left at the last point
+	 *  tried, which is in collision, and <em>GetCandidateEdges</em>
+	 *  leaves it without edges.
+	 */
+	virtual void SamplePoint(const int i, RandomStream * const rng, double p[2]) const;
+
+	/**
+	 *@brief Get the candidate edges <em>(u, v)</em>, <em>u < v</em>,
+	 *       between each vertex and its nearest vertices, sorted
+	 */
+	void GetCandidateEdges(std::vector<int> * const sources, std::vector<int> * const targets);
+
+	/**
+	 *@brief Set the graph from the edges with <em>valid[i]</em> true
+	 */
+	void SetGraph(const std::vector<int> & sources, const std::vector<int> & targets,
+		      const std::vector<char> & valid);
+
+	/**
+	 *@brief Check edge <em>(u, v)</em> if it was not checked before and
+	 *       record the result for both of its directions
+	 */
+	bool CheckEdge(const int u, const int v);
+
+	enum
+	    {
+		EDGE_UNKNOWN = 0,
+		EDGE_VALID   = 1,
+		EDGE_INVALID = 2
+	    };
+
+	std::vector<Polygon2D*> m_obstacles;
+	std::vector<char>       m_convex;
+	std::vector<double>     m_bboxes;
+	double                  m_bbox[4];
+	std::vector<double>     m_points;
+	KDTree2D                m_tree;
+	CSRGraph                m_graph;
+	std::vector<char>       m_edgeStates;
+	int                     m_nrEdgeChecks;
+	PRMSearchInfo           m_searchInfo;
+	DenseGraphSearch        m_search;
+    };
+}
+
+#endif
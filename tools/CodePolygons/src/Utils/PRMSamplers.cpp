@@ -0,0 +1,152 @@
+#include "Utils/PRMSamplers.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace Abetare
+{
+    static void SampleUniformPoint(const PRM & prm, RandomStream * const rng, double p[2])
+    {
+	const double *bbox = prm.GetBoundingBox();
+
+	p[0] = rng->UniformReal(bbox[0], bbox[2]);
+	p[1] = rng->UniformReal(bbox[1], bbox[3]);
+    }
+
+    bool PRMUniformSampler::Sample(const PRM & prm, RandomStream * const rng, double p[2]) const
+    {
+	SampleUniformPoint(prm, rng, p);
+
+	return prm.IsPointValid(p);
+    }
+
+    bool PRMGaussianSampler::Sample(const PRM & prm, RandomStream * const rng, double p[2]) const
+    {
+	double q[2];
+
+	SampleUniformPoint(prm, rng, q);
+	p[0] = rng->GaussianReal(q[0], m_stddev);
+	p[1] = rng->GaussianReal(q[1], m_stddev);
+
+	const bool qvalid = prm.IsPointValid(q);
+
+	if(qvalid == prm.IsPointValid(p))
+	    return false;
+	if(qvalid)
+	{
+	    p[0] = q[0];
+	    p[1] = q[1];
+	}
+
+	return true;
+    }
+
+    bool PRMBridgeSampler::Sample(const PRM & prm, RandomStream * const rng, double p[2]) const
+    {
+	double q[2];
+
+	SampleUniformPoint(prm, rng, q);
+	if(prm.IsPointValid(q))
+	    return false;
+
+	p[0] = rng->GaussianReal(q[0], m_stddev);
+	p[1] = rng->GaussianReal(q[1], m_stddev);
+	if(prm.IsPointValid(p))
+	    return false;
+
+	p[0] = 0.5 * (p[0] + q[0]);
+	p[1] = 0.5 * (p[1] + q[1]);
+
+	return prm.IsPointValid(p);
+    }
+
+    void PRMBoundarySampler::Setup(const PRM & prm)
+    {
+	double total = 0;
+
+	m_obstacles.clear();
+	m_vertices.clear();
+	m_lengths.clear();
+	for(int i = 0; i < prm.GetNrObstacles(); ++i)
+	{
+	    const std::vector<double> & poly = prm.GetObstacle(i)->m_vertices;
+	    const int                   n    = poly.size() / 2;
+
+	    for(int j = 0; j < n; ++j)
+	    {
+		const int k = (j + 1) % n;
+
+		total += sqrt((poly[2 * k] - poly[2 * j]) * (poly[2 * k] - poly[2 * j]) +
+			      (poly[2 * k + 1] - poly[2 * j + 1]) * (poly[2 * k + 1] - poly[2 * j + 1]));
+		m_obstacles.push_back(i);
+		m_vertices.push_back(j);
+		m_lengths.push_back(total);
+	    }
+	}
+    }
+
+    bool PRMBoundarySampler::Sample(const PRM & prm, RandomStream * const rng, double p[2]) const
+    {
+	if(m_lengths.empty() || m_lengths.back() <= 0)
+	    return false;
+
+	const int e = std::upper_bound(m_lengths.begin(), m_lengths.end(),
+				       rng->UniformReal(0, m_lengths.back())) - m_lengths.begin();
+
+	if(e >= (int) m_lengths.size())
+	    return false;
+
+	const std::vector<double> & poly = prm.GetObstacle(m_obstacles[e])->m_vertices;
+	const int                   j    = m_vertices[e];
+	const int                   k    = (j + 1) % (poly.size() / 2);
+	const double                dx   = poly[2 * k] - poly[2 * j];
+	const double                dy   = poly[2 * k + 1] - poly[2 * j + 1];
+	const double                len  = sqrt(dx * dx + dy * dy);
+	const double                t    = rng->UniformReal();
+	const double                d    = fabs(rng->GaussianReal(0, m_stddev)) / (len > 0 ? len : 1);
+	const double                x    = poly[2 * j] + t * dx;
+	const double                y    = poly[2 * j + 1] + t * dy;
+
+	//outward normal of a counterclockwise polygon, scaled by d
+	p[0] = x + d * dy;
+	p[1] = y - d * dx;
+	if(prm.IsPointValid(p))
+	    return true;
+
+	p[0] = x - d * dy;
+	p[1] = y + d * dx;
+
+	return prm.IsPointValid(p);
+    }
+
+    bool PRMQuasiRandomSampler::Sample(const PRM & prm, RandomStream * const rng, double p[2]) const
+    {
+	return SamplePoint(prm, rng->UniformInteger(0, 0x7FFFFFFF), rng, p);
+    }
+
+    bool PRMQuasiRandomSampler::SamplePoint(const PRM & prm, const int i, RandomStream * const rng, double p[2]) const
+    {
+	double u[2], v[2];
+
+	m_sequence.GetPoint(i, u);
+	for(int k = 0; k < m_maxAttempts; ++k)
+	{
+	    v[0] = k == 0 ? u[0] : u[0] + rng->UniformReal();
+	    v[1] = k == 0 ? u[1] : u[1] + rng->UniformReal();
+	    v[0] -= floor(v[0]);
+	    v[1] -= floor(v[1]);
+	    MapUnitSquareToAABox2D(v, prm.GetBoundingBox(), prm.GetBoundingBox() + 2, p);
+	    if(prm.IsPointValid(p))
+		return true;
+	}
+
+	return false;
+    }
+
+    const PRMSampler* PRMMixedSampler::SelectSampler(RandomStream * const rng) const
+    {
+	const int i = std::upper_bound(m_weights.begin(), m_weights.end(),
+				       rng->UniformReal(0, m_weights.back())) - m_weights.begin();
+
+	return m_samplers[i < (int) m_samplers.size() ? i : m_samplers.size() - 1];
+    }
+}
@@ -0,0 +1,221 @@
+#ifndef ABETARE__PRM_SAMPLERS_HPP_
+#define ABETARE__PRM_SAMPLERS_HPP_
+
+#include "Utils/PRM.hpp"
+#include "Utils/PseudoRandom.hpp"
+#include "Utils/QuasiRandom.hpp"
+#include <vector>
+
+namespace Abetare
+{
+    /**
+     *@brief Strategy for the points of a <em>PRM</em>
+     *
+     *@par Description:
+     *  The roadmap calls <em>SamplePoint</em> for each point, which by
+     *  default calls <em>Sample</em> until it accepts a point, at most
+     *  <em>m_maxAttempts</em> times. Calls come from several threads,
+     *  each with the <em>RandomStream</em> of its block, so they must
+     *  not modify the sampler. Anything derived from the obstacles is
+     *  computed in <em>Setup</em>, which <em>PRM::Build</em> calls
+     *  first.
+     */
+    class PRMSampler
+    {
+    public:
+	PRMSampler(void)
+	{
+	    m_maxAttempts = 10000;
+	}
+
+	virtual ~PRMSampler(void)
+	{
+	}
+
+	int m_maxAttempts;
+
+	virtual void Setup(const PRM & prm)
+	{
+	}
+
+	/**
+	 *@brief Make one attempt and return true if <em>p</em> is set to
+	 *       an accepted collision-free point
+	 */
+	virtual bool Sample(const PRM & prm, RandomStream * const rng, double p[2]) const = 0;
+
+	/**
+	 *@brief Make attempts for sample <em>i</em> of the roadmap until
+	 *       one is accepted
+	 *
+	 *@par Description:
+	 *  The index matters only to samplers that follow a sequence.
+	 *
+	 *@returns false if all of them failed
+	 */
+	virtual bool SamplePoint(const PRM & prm, const int i, RandomStream * const rng, double p[2]) const
+	{
+	    for(int k = 0; k < m_maxAttempts; ++k)
+		if(Sample(prm, rng, p))
+		    return true;
+	    return false;
+	}
+    };
+
+    /**
+     *@brief Uniform points in the bounding box, as without a sampler
+     */
+    class PRMUniformSampler : public PRMSampler
+    {
+    public:
+	virtual bool Sample(const PRM & prm, RandomStream * const rng, double p[2]) const;
+    };
+
+    /**
+     *@brief Gaussian sampling: of a uniform point and a point at a
+     *       Gaussian distance from it, keep the free one when the
+     *       other is in collision
+     *
+     *@par Description:
+     *  Samples fall near the obstacle boundaries, at a distance of the
+     *  order of <em>m_stddev</em>, and not in open space.
+     */
+    class PRMGaussianSampler : public PRMSampler
+    {
+    public:
+	PRMGaussianSampler(void) : PRMSampler()
+	{
+	    m_stddev = 1.0;
+	}
+
+	double m_stddev;
+
+	virtual bool Sample(const PRM & prm, RandomStream * const rng, double p[2]) const;
+    };
+
+    /**
+     *@brief Bridge test: of two points in collision, at a Gaussian
+     *       distance from each other, keep the midpoint when it is free
+     *
+     *@par Description:
+     *  Midpoints of short bridges are mostly in narrow passages, so few
+     *  samples are wasted in open space. Points outside the bounding
+     *  box count as being in collision. Since open space gets almost
+     *  no samples, the bridge test is usually combined with uniform
+     *  sampling through <em>PRMMixedSampler</em>.
+     */
+    class PRMBridgeSampler : public PRMSampler
+    {
+    public:
+	PRMBridgeSampler(void) : PRMSampler()
+	{
+	    m_stddev = 1.0;
+	}
+
+	double m_stddev;
+
+	virtual bool Sample(const PRM & prm, RandomStream * const rng, double p[2]) const;
+    };
+
+    /**
+     *@brief Points on the obstacle boundaries, chosen uniformly by
+     *       length, moved off the boundary by a Gaussian distance
+     *
+     *@par Description:
+     *  The point is moved along the outward normal of the edge, which
+     *  assumes counterclockwise polygons, and along the inward normal
+     *  when that is in collision.
+     */
+    class PRMBoundarySampler : public PRMSampler
+    {
+    public:
+	PRMBoundarySampler(void) : PRMSampler()
+	{
+	    m_stddev = 0.5;
+	}
+
+	double m_stddev;
+
+	virtual void Setup(const PRM & prm);
+
+	virtual bool Sample(const PRM & prm, RandomStream * const rng, double p[2]) const;
+
+    protected:
+	/**
+	 *@brief Edges as obstacle id and first vertex, with the total
+	 *       length of the edges up to each one
+	 */
+	std::vector<int>    m_obstacles;
+	std::vector<int>    m_vertices;
+	std::vector<double> m_lengths;
+    };
+
+    /**
+     *@brief Point <em>i</em> of a low-discrepancy sequence, mapped to
+     *       the bounding box, for sample <em>i</em>
+     *
+     *@par Description:
+     *  When that point is in collision, the following attempts shift
+     *  it modulo the box by a random vector, which keeps the points
+     *  spread out while staying independent of the number of threads.
+     */
+    class PRMQuasiRandomSampler : public PRMSampler
+    {
+    public:
+	QuasiRandom m_sequence;
+
+	virtual bool Sample(const PRM & prm, RandomStream * const rng, double p[2]) const;
+
+	virtual bool SamplePoint(const PRM & prm, const int i, RandomStream * const rng, double p[2]) const;
+    };
+
+    /**
+     *@brief Pick one of several samplers at random, in proportion to
+     *       their weights, for each point
+     *
+     *@par Description:
+     *  Points are shared by weight and not attempts, so a sampler that
+     *  rejects most attempts, as the bridge test does, still gets its
+     *  share of the roadmap.
+     */
+    class PRMMixedSampler : public PRMSampler
+    {
+    public:
+	/**
+	 *@brief Add <em>sampler</em>, which must stay alive while used
+	 */
+	void AddSampler(PRMSampler * const sampler, const double weight)
+	{
+	    m_samplers.push_back(sampler);
+	    m_weights.push_back((m_weights.empty() ? 0 : m_weights.back()) + weight);
+	}
+
+	virtual void Setup(const PRM & prm)
+	{
+	    for(int i = 0; i < (int) m_samplers.size(); ++i)
+		m_samplers[i]->Setup(prm);
+	}
+
+	virtual bool Sample(const PRM & prm, RandomStream * const rng, double p[2]) const
+	{
+	    return !m_samplers.empty() && SelectSampler(rng)->Sample(prm, rng, p);
+	}
+
+	virtual bool SamplePoint(const PRM & prm, const int i, RandomStream * const rng, double p[2]) const
+	{
+	    return !m_samplers.empty() && SelectSampler(rng)->SamplePoint(prm, i, rng, p);
+	}
+
+    protected:
+	const PRMSampler* SelectSampler(RandomStream * const rng) const;
+
+	std::vector<PRMSampler*> m_samplers;
+
+	/**
+	 *@brief Sum of the weights up to each sampler
+	 */
+	std::vector<double>      m_weights;
+    };
+}
+
+#endif
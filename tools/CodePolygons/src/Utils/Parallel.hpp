@@ -0,0 +1,70 @@
+#ifndef ABETARE__PARALLEL_HPP_
+#define ABETARE__PARALLEL_HPP_
+
+#include <vector>
+#include <thread>
+#include <atomic>
+
+namespace Abetare
+{
+    /**
+     *@brief Number of threads to use when the caller does not specify it
+     */
+    static inline int GetNrHardwareThreads(void)
+    {
+	const int n = std::thread::hardware_concurrency();
+	return n > 0 ? n : 1;
+    }
+
+    /**
+     *@brief Run <em>fn(i, t)</em> for every <em>i</em> in
+     *       <em>[0, n)</em> on <em>nrThreads</em> threads
+     *
+     *@par Description:
+     *  Iterations are handed out in chunks of <em>chunk</em> consecutive
+     *  indices from a shared atomic counter, so uneven iterations are
+     *  balanced. The argument <em>t</em> in <em>[0, nrThreads)</em>
+     *  identifies the worker and can be used to index per-thread
+     *  buffers without locking. The calling thread acts as worker 0.
+     *  If <em>nrThreads <= 0</em>, the number of hardware threads is used.
+     */
+    template <typename Fn>
+    void ParallelFor(const int n, int nrThreads, Fn fn, const int chunk = 1)
+    {
+	if(nrThreads <= 0)
+	    nrThreads = GetNrHardwareThreads();
+	if(nrThreads > n)
+	    nrThreads = n > 0 ? n : 1;
+
+	if(nrThreads == 1)
+	{
+	    for(int i = 0; i < n; ++i)
+		fn(i, 0);
+	    return;
+	}
+
+	std::atomic<int>         next(0);
+	std::vector<std::thread> workers;
+
+	struct Worker
+	{
+	    static void Run(const int n, const int chunk, const int t, std::atomic<int> * const next, Fn * const fn)
+	    {
+		for(int start = next->fetch_add(chunk); start < n; start = next->fetch_add(chunk))
+		{
+		    const int end = start + chunk < n ? start + chunk : n;
+		    for(int i = start; i < end; ++i)
+			(*fn)(i, t);
+		}
+	    }
+	};
+
+	for(int t = 1; t < nrThreads; ++t)
+	    workers.push_back(std::thread(Worker::Run, n, chunk, t, &next, &fn));
+	Worker::Run(n, chunk, 0, &next, &fn);
+	for(int t = 0; t < (int) workers.size(); ++t)
+	    workers[t].join();
+    }
+}
+
+#endif
@@ -211,6 +211,92 @@ namespace Abetare
      */
     
     int RandomSelectWeighted(const int n, const double weights[], const double tw);
+
+    /**
+     *@brief Random number generator with its own state
+     *
+     *@par Description:
+     *  The functions above share the state of <em>random</em>, so their
+     *  numbers depend on the order of the calls across threads. Each
+     *  thread, or each block of work, can instead use its own stream
+     *  seeded from a common seed and the block id, which gives the same
+     *  numbers for any number of threads. The generator is splitmix64,
+     *  which is fast and passes the usual statistical tests.
+     */
+    class RandomStream
+    {
+    public:
+	RandomStream(const unsigned long long seed = 0)
+	{
+	    Seed(seed);
+	}
+
+	/**
+	 *@brief Seed the stream from <em>seed</em> and a stream id,
+	 *       e.g., the id of the block of work
+	 */
+	void Seed(const unsigned long long seed, const unsigned long long id = 0)
+	{
+	    m_state = seed;
+	    m_state = Next() ^ (id * 0xD1B54A32D192ED03ULL);
+	}
+
+	unsigned long long Next(void)
+	{
+	    unsigned long long z = (m_state += 0x9E3779B97F4A7C15ULL);
+
+	    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	    return z ^ (z >> 31);
+	}
+
+	/**
+	 *@brief Real number uniformly at random from <em>[0, 1)</em>
+	 */
+	double UniformReal(void)
+	{
+	    return (Next() >> 11) * (1.0 / 9007199254740992.0);
+	}
+
+	double UniformReal(const double min, const double max)
+	{
+	    return min + (max - min) * UniformReal();
+	}
+
+	/**
+	 *@brief Integer uniformly at random from <em>[min, max]</em>
+	 */
+	long UniformInteger(const long min, const long max)
+	{
+	    return min + (long) (UniformReal() * (max - min + 1));
+	}
+
+	/**
+	 *@brief Real number at random from the Gaussian distribution, with
+	 *       the polar method of <em>RandomGaussianReal</em>
+	 *
+	 *@par Description:
+	 *  The second number of each pair is not kept, so the stream stays
+	 *  a single integer of state.
+	 */
+	double GaussianReal(const double mean, const double stddev)
+	{
+	    double x1, x2, w;
+
+	    do
+	    {
+		x1 = 2.0 * UniformReal() - 1.0;
+		x2 = 2.0 * UniformReal() - 1.0;
+		w  = x1 * x1 + x2 * x2;
+	    }
+	    while(w >= 1.0 || w == 0.0);
+
+	    return mean + stddev * x1 * sqrt(-2.0 * log(w) / w);
+	}
+
+    protected:
+	unsigned long long m_state;
+    };
     
 }
 
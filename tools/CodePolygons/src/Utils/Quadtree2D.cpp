@@ -0,0 +1,190 @@
+#include "Utils/Quadtree2D.hpp"
+#include "Utils/Geometry.hpp"
+#include "Utils/Constants.hpp"
+
+namespace Abetare
+{
+    void Quadtree2D::Setup(const double min[2],
+			   const double max[2],
+			   const double minSize)
+    {
+	m_min[0]  = min[0];
+	m_min[1]  = min[1];
+	m_max[0]  = max[0];
+	m_max[1]  = max[1];
+	m_minSize = minSize;
+	m_nodes.clear();
+	m_leaves.clear();
+    }
+
+    void Quadtree2D::Build(const int nrPolys, Polygon2D * const polys[])
+    {
+	std::vector<int> cands;
+	Node             root;
+
+	m_nodes.clear();
+	m_leaves.clear();
+
+	for(int i = 0; i < nrPolys; ++i)
+	    cands.push_back(i);
+
+	root.m_min[0]  = m_min[0];
+	root.m_min[1]  = m_min[1];
+	root.m_max[0]  = m_max[0];
+	root.m_max[1]  = m_max[1];
+	root.m_parent  = Constants::ID_UNDEFINED;
+	root.m_depth   = 0;
+	root.m_children[0] = root.m_children[1] =
+	    root.m_children[2] = root.m_children[3] = Constants::ID_UNDEFINED;
+	m_nodes.push_back(root);
+
+	Subdivide(0, polys, &cands);
+    }
+
+    int Quadtree2D::GetNrLeaves(const int status) const
+    {
+	const int n     = m_leaves.size();
+	int       count = 0;
+
+	for(int i = 0; i < n; ++i)
+	    if(m_nodes[m_leaves[i]].m_status == status)
+		++count;
+	return count;
+    }
+
+    int Quadtree2D::Classify(const double min[2],
+			     const double max[2],
+			     Polygon2D * const polys[],
+			     const std::vector<int> * const cands,
+			     std::vector<int> * const overlap) const
+    {
+	const int n = cands->size();
+	double    box[8];
+
+	AABoxAsPolygon2D(min, max, box);
+	overlap->clear();
+
+	for(int i = 0; i < n; ++i)
+	{
+	    Polygon2D    *poly = polys[(*cands)[i]];
+	    const double *bbox = poly->GetBoundingBox();
+	    const int     nv   = poly->m_vertices.size() / 2;
+	    const double *v    = &(poly->m_vertices[0]);
+
+	    if(!CollisionAABoxes2D(min, max, bbox, &bbox[2]))
+		continue;
+
+	    if(IntersectPolygons2D(4, box, nv, v))
+		overlap->push_back((*cands)[i]);
+	    else if(IsPolygonInsidePolygon2D(4, box, nv, v, false))
+		return STATUS_OCCUPIED;
+	    else if(IsPolygonInsideAABox2D(nv, v, min, max))
+		overlap->push_back((*cands)[i]);
+	}
+
+	return overlap->size() > 0 ? STATUS_MIXED : STATUS_FREE;
+    }
+
+    void Quadtree2D::Subdivide(const int i,
+			       Polygon2D * const polys[],
+			       const std::vector<int> * const cands)
+    {
+	std::vector<int> overlap;
+	const int status = Classify(m_nodes[i].m_min, m_nodes[i].m_max, polys, cands, &overlap);
+
+	m_nodes[i].m_status = status;
+	if(status != STATUS_MIXED ||
+	   0.5 * (m_nodes[i].m_max[0] - m_nodes[i].m_min[0]) < m_minSize ||
+	   0.5 * (m_nodes[i].m_max[1] - m_nodes[i].m_min[1]) < m_minSize)
+	{
+	    m_leaves.push_back(i);
+	    return;
+	}
+
+	const double mid[2] =
+	    {
+		0.5 * (m_nodes[i].m_min[0] + m_nodes[i].m_max[0]),
+		0.5 * (m_nodes[i].m_min[1] + m_nodes[i].m_max[1])
+	    };
+
+	//children are stored in the order: SW, SE, NW, NE
+	for(int c = 0; c < 4; ++c)
+	{
+	    Node child;
+
+	    child.m_min[0] = (c & 1) ? mid[0] : m_nodes[i].m_min[0];
+	    child.m_max[0] = (c & 1) ? m_nodes[i].m_max[0] : mid[0];
+	    child.m_min[1] = (c & 2) ? mid[1] : m_nodes[i].m_min[1];
+	    child.m_max[1] = (c & 2) ? m_nodes[i].m_max[1] : mid[1];
+	    child.m_parent = i;
+	    child.m_depth  = m_nodes[i].m_depth + 1;
+	    child.m_children[0] = child.m_children[1] =
+		child.m_children[2] = child.m_children[3] = Constants::ID_UNDEFINED;
+
+	    m_nodes[i].m_children[c] = m_nodes.size();
+	    m_nodes.push_back(child);
+	}
+
+	for(int c = 0; c < 4; ++c)
+	    Subdivide(m_nodes[i].m_children[c], polys, &overlap);
+    }
+
+    int Quadtree2D::LocateLeaf(const double p[2]) const
+    {
+	if(m_nodes.empty() ||
+	   p[0] < m_min[0] || p[0] > m_max[0] ||
+	   p[1] < m_min[1] || p[1] > m_max[1])
+	    return Constants::ID_UNDEFINED;
+
+	int i = 0;
+	while(!IsLeaf(i))
+	{
+	    const Node  *node = &(m_nodes[i]);
+	    const double midx = 0.5 * (node->m_min[0] + node->m_max[0]);
+	    const double midy = 0.5 * (node->m_min[1] + node->m_max[1]);
+
+	    i = node->m_children[(p[0] >= midx ? 1 : 0) + (p[1] >= midy ? 2 : 0)];
+	}
+	return i;
+    }
+
+    void Quadtree2D::GetNeighs(const int i, std::vector<int> * const neighs, const bool corners) const
+    {
+	if(!m_nodes.empty())
+	    GetNeighs(i, 0, corners, neighs);
+    }
+
+    void Quadtree2D::GetNeighs(const int i,
+			       const int curr,
+			       const bool corners,
+			       std::vector<int> * const neighs) const
+    {
+	const Node  *a   = &(m_nodes[i]);
+	const Node  *b   = &(m_nodes[curr]);
+	const double tol = Constants::EPSILON * (1 + m_max[0] - m_min[0] + m_max[1] - m_min[1]);
+
+	if(b->m_min[0] > a->m_max[0] + tol || b->m_max[0] < a->m_min[0] - tol ||
+	   b->m_min[1] > a->m_max[1] + tol || b->m_max[1] < a->m_min[1] - tol)
+	    return;
+
+	if(!IsLeaf(curr))
+	{
+	    for(int c = 0; c < 4; ++c)
+		GetNeighs(i, b->m_children[c], corners, neighs);
+	    return;
+	}
+
+	if(curr == i)
+	    return;
+
+	//length of the overlap along each axis: a shared edge has one
+	//positive overlap, while a shared corner has none
+	const double ox = (a->m_max[0] < b->m_max[0] ? a->m_max[0] : b->m_max[0]) -
+	    (a->m_min[0] > b->m_min[0] ? a->m_min[0] : b->m_min[0]);
+	const double oy = (a->m_max[1] < b->m_max[1] ? a->m_max[1] : b->m_max[1]) -
+	    (a->m_min[1] > b->m_min[1] ? a->m_min[1] : b->m_min[1]);
+
+	if(corners || ox > tol || oy > tol)
+	    neighs->push_back(curr);
+    }
+}
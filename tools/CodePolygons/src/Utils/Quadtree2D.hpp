@@ -0,0 +1,127 @@
+#ifndef ABETARE__QUADTREE2D_HPP_
+#define ABETARE__QUADTREE2D_HPP_
+
+#include "Utils/Polygon2D.hpp"
+#include <vector>
+
+namespace Abetare
+{
+    /**
+     *@brief Adaptive quadtree decomposition of a 2D workspace
+     *
+     *@par Description:
+     *  The root box is recursively split into four quadrants. A node is
+     *  a leaf when it is fully free, fully occupied, or when its sides
+     *  reach the minimum size, in which case it is marked as mixed.
+     *  Large open regions are therefore covered by a few large leaves
+     *  while obstacle boundaries are resolved down to the minimum size.
+     */
+    class Quadtree2D
+    {
+    public:
+	Quadtree2D(void)
+	{
+	    m_min[0] = m_min[1] = 0;
+	    m_max[0] = m_max[1] = 0;
+	    m_minSize = 0;
+	}
+
+	virtual ~Quadtree2D(void)
+	{
+	}
+
+	enum Status
+	    {
+		STATUS_FREE     = 0,
+		STATUS_OCCUPIED = 1,
+		STATUS_MIXED    = 2
+	    };
+
+	struct Node
+	{
+	    double m_min[2];
+	    double m_max[2];
+	    int    m_status;
+	    int    m_parent;
+	    int    m_depth;
+	    int    m_children[4];
+	};
+
+	virtual void Setup(const double min[2],
+			   const double max[2],
+			   const double minSize);
+
+	virtual void Build(const int nrPolys, Polygon2D * const polys[]);
+
+	int GetNrNodes(void) const
+	{
+	    return m_nodes.size();
+	}
+
+	const Node* GetNode(const int i) const
+	{
+	    return &(m_nodes[i]);
+	}
+
+	bool IsLeaf(const int i) const
+	{
+	    return m_nodes[i].m_children[0] < 0;
+	}
+
+	int GetNrLeaves(void) const
+	{
+	    return m_leaves.size();
+	}
+
+	int GetLeaf(const int i) const
+	{
+	    return m_leaves[i];
+	}
+
+	int GetNrLeaves(const int status) const;
+
+	void GetNodeCenter(const int i, double c[2]) const
+	{
+	    c[0] = 0.5 * (m_nodes[i].m_min[0] + m_nodes[i].m_max[0]);
+	    c[1] = 0.5 * (m_nodes[i].m_min[1] + m_nodes[i].m_max[1]);
+	}
+
+	/**
+	 *@brief Returns the leaf that contains <em>p</em> or
+	 *       <em>Constants::ID_UNDEFINED</em> if <em>p</em> is
+	 *       outside the root box
+	 */
+	int LocateLeaf(const double p[2]) const;
+
+	/**
+	 *@brief Get the leaves whose boxes share a boundary segment with
+	 *       the box of leaf <em>i</em> (and also a single corner when
+	 *       <em>corners</em> is true)
+	 */
+	void GetNeighs(const int i, std::vector<int> * const neighs, const bool corners = true) const;
+
+    protected:
+	int  Classify(const double min[2],
+		      const double max[2],
+		      Polygon2D * const polys[],
+		      const std::vector<int> * const cands,
+		      std::vector<int> * const overlap) const;
+
+	void Subdivide(const int i,
+		       Polygon2D * const polys[],
+		       const std::vector<int> * const cands);
+
+	void GetNeighs(const int i,
+		       const int curr,
+		       const bool corners,
+		       std::vector<int> * const neighs) const;
+
+	double            m_min[2];
+	double            m_max[2];
+	double            m_minSize;
+	std::vector<Node> m_nodes;
+	std::vector<int>  m_leaves;
+    };
+}
+
+#endif
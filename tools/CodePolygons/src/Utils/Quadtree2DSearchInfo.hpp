@@ -0,0 +1,156 @@
+#ifndef ABETARE__QUADTREE2D_SEARCH_INFO_HPP_
+#define ABETARE__QUADTREE2D_SEARCH_INFO_HPP_
+
+#include "Utils/GraphSearch.hpp"
+#include "Utils/Quadtree2D.hpp"
+#include <cmath>
+
+namespace Abetare
+{
+    /**
+     *@brief Lets <em>GraphSearch<int></em> search over the leaves of
+     *       a quadtree
+     *
+     *@par Description:
+     *  Keys are node ids of leaves. Only free leaves are traversed,
+     *  unless <em>m_allowMixed</em> is set. Edge costs and the heuristic
+     *  use the distance between leaf centers, with the goal leaf
+     *  represented by the goal point.
+     *  \n\n
+     *  Leaves that touch only at a corner are connected only when the
+     *  two leaves beside that corner are traversable too, so paths do
+     *  not cut diagonally between occupied leaves, as on the grid.
+     */
+    class Quadtree2DSearchInfo : public GraphSearchInfo<int>
+    {
+    public:
+	Quadtree2DSearchInfo(void) : GraphSearchInfo<int>()
+	{
+	    m_quadtree   = NULL;
+	    m_allowMixed = false;
+	    m_goalLeaf   = Constants::ID_UNDEFINED;
+	    m_goal[0]    = m_goal[1] = 0;
+	}
+
+	virtual ~Quadtree2DSearchInfo(void)
+	{
+	}
+
+	const Quadtree2D *m_quadtree;
+	bool              m_allowMixed;
+
+	bool SetGoal(const double goal[2])
+	{
+	    m_goal[0]  = goal[0];
+	    m_goal[1]  = goal[1];
+	    m_goalLeaf = m_quadtree->LocateLeaf(goal);
+	    return m_goalLeaf >= 0 && IsTraversable(m_goalLeaf);
+	}
+
+	int GetGoalLeaf(void) const
+	{
+	    return m_goalLeaf;
+	}
+
+	bool IsTraversable(const int leaf) const
+	{
+	    const int status = m_quadtree->GetNode(leaf)->m_status;
+
+	    return status == Quadtree2D::STATUS_FREE ||
+		(m_allowMixed && status == Quadtree2D::STATUS_MIXED);
+	}
+
+	virtual void GetOutEdges(const int u,
+				 std::vector<int> * const edges,
+				 std::vector<double> * const costs = NULL) const
+	{
+	    std::vector<int> neighs;
+	    double           cu[2], cv[2];
+
+	    m_quadtree->GetNeighs(u, &neighs);
+	    GetPoint(u, cu);
+
+	    const int n = neighs.size();
+	    for(int i = 0; i < n; ++i)
+		if(IsTraversable(neighs[i]) && IsCornerFree(u, neighs[i]))
+		{
+		    edges->push_back(neighs[i]);
+		    if(costs)
+		    {
+			GetPoint(neighs[i], cv);
+			costs->push_back(sqrt((cu[0] - cv[0]) * (cu[0] - cv[0]) +
+					      (cu[1] - cv[1]) * (cu[1] - cv[1])));
+		    }
+		}
+	}
+
+	virtual bool IsGoal(const int key) const
+	{
+	    return key == m_goalLeaf;
+	}
+
+	virtual double HeuristicCostToGoal(const int u) const
+	{
+	    double c[2];
+
+	    GetPoint(u, c);
+	    return sqrt((c[0] - m_goal[0]) * (c[0] - m_goal[0]) +
+			(c[1] - m_goal[1]) * (c[1] - m_goal[1]));
+	}
+
+    protected:
+	/**
+	 *@brief Returns true unless leaves <em>u</em> and <em>v</em> touch
+	 *       only at a corner with a leaf beside it that is not
+	 *       traversable
+	 */
+	bool IsCornerFree(const int u, const int v) const
+	{
+	    const Quadtree2D::Node *a = m_quadtree->GetNode(u);
+	    const Quadtree2D::Node *b = m_quadtree->GetNode(v);
+	    const double            sa = a->m_max[0] - a->m_min[0];
+	    const double            sb = b->m_max[0] - b->m_min[0];
+	    const double            d  = 1e-3 * (sa < sb ? sa : sb);
+	    double                  c[2], s[2], p[2];
+
+	    for(int k = 0; k < 2; ++k)
+	    {
+		if(b->m_min[k] < a->m_max[k] - d && b->m_max[k] > a->m_min[k] + d)
+		    return true;
+
+		//corner shared by the boxes and direction from a to b
+		s[k] = b->m_min[k] >= a->m_max[k] - d ? 1 : -1;
+		c[k] = s[k] > 0 ? a->m_max[k] : a->m_min[k];
+	    }
+
+	    for(int k = 0; k < 2; ++k)
+	    {
+		p[k]     = c[k] + s[k] * d;
+		p[1 - k] = c[1 - k] - s[1 - k] * d;
+
+		const int leaf = m_quadtree->LocateLeaf(p);
+
+		if(leaf < 0 || !IsTraversable(leaf))
+		    return false;
+	    }
+
+	    return true;
+	}
+
+	void GetPoint(const int leaf, double p[2]) const
+	{
+	    if(leaf == m_goalLeaf)
+	    {
+		p[0] = m_goal[0];
+		p[1] = m_goal[1];
+	    }
+	    else
+		m_quadtree->GetNodeCenter(leaf, p);
+	}
+
+	int    m_goalLeaf;
+	double m_goal[2];
+    };
+}
+
+#endif
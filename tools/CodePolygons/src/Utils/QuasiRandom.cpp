@@ -0,0 +1,148 @@
+#include "Utils/QuasiRandom.hpp"
+#include "Utils/PseudoRandom.hpp"
+#include <cmath>
+
+namespace Abetare
+{
+    //1 / g and 1 / g^2, with g the plastic number, root of x^3 = x + 1
+    static const double R2_ALPHA1 = 0.7548776662466927;
+    static const double R2_ALPHA2 = 0.5698402909980532;
+
+    static unsigned int ReverseBits(unsigned int x)
+    {
+	x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+	x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+	x = ((x >> 4) & 0x0F0F0F0Fu) | ((x & 0x0F0F0F0Fu) << 4);
+	x = ((x >> 8) & 0x00FF00FFu) | ((x & 0x00FF00FFu) << 8);
+	return (x >> 16) | (x << 16);
+    }
+
+    /*
+     * Owen scrambling: each bit is flipped depending on the bits above
+     * it, with the hash of Laine and Karras applied to the reversed bits
+     */
+    static unsigned int NestedUniformScramble(unsigned int x, const unsigned int seed)
+    {
+	x  = ReverseBits(x);
+	x += seed;
+	x ^= x * 0x6C50B47Cu;
+	x ^= x * 0xB82F1E52u;
+	x ^= x * 0xC7AFE638u;
+	x ^= x * 0x8D22F6E6u;
+	return ReverseBits(x);
+    }
+
+    static double RadicalInverse3(unsigned int i)
+    {
+	double r = 0;
+	double f = 1.0 / 3;
+
+	for(; i > 0; i /= 3, f /= 3)
+	    r += f * (i % 3);
+	return r;
+    }
+
+    static double Fraction(const double x)
+    {
+	return x - floor(x);
+    }
+
+    void QuasiRandom::Setup(const Sequence sequence, const unsigned long long seed)
+    {
+	RandomStream rng(seed);
+
+	m_sequence = sequence;
+	m_index    = 0;
+	m_scramble = seed != 0;
+	for(int i = 0; i < 3; ++i)
+	    m_seeds[i] = (unsigned int) rng.Next();
+	for(int i = 0; i < 2; ++i)
+	    m_shift[i] = m_scramble ? rng.UniformReal() : 0;
+    }
+
+    void QuasiRandom::GetPoint(const unsigned int i, double u[2]) const
+    {
+	if(m_sequence == HALTON)
+	{
+	    u[0] = Fraction(ReverseBits(i) * (1.0 / 4294967296.0) + m_shift[0]);
+	    u[1] = Fraction(RadicalInverse3(i) + m_shift[1]);
+	}
+	else if(m_sequence == R2)
+	{
+	    u[0] = Fraction(0.5 + i * R2_ALPHA1 + m_shift[0]);
+	    u[1] = Fraction(0.5 + i * R2_ALPHA2 + m_shift[1]);
+	}
+	else
+	{
+	    //shuffle the order of the points too, so prefixes differ by seed
+	    const unsigned int j = m_scramble ? NestedUniformScramble(i, m_seeds[0]) : i;
+	    unsigned int       x = ReverseBits(j);
+	    unsigned int       y = 0;
+	    unsigned int       v = 1u << 31;
+
+	    //second dimension: direction numbers of the polynomial x + 1
+	    for(unsigned int k = j; k > 0; k >>= 1, v ^= v >> 1)
+		if(k & 1)
+		    y ^= v;
+
+	    if(m_scramble)
+	    {
+		x = NestedUniformScramble(x, m_seeds[1]);
+		y = NestedUniformScramble(y, m_seeds[2]);
+	    }
+	    u[0] = x * (1.0 / 4294967296.0);
+	    u[1] = y * (1.0 / 4294967296.0);
+	}
+    }
+
+    void MapUnitSquareToAABox2D(const double u[2],
+				const double min[2],
+				const double max[2],
+				double       p[2])
+    {
+	p[0] = min[0] + u[0] * (max[0] - min[0]);
+	p[1] = min[1] + u[1] * (max[1] - min[1]);
+    }
+
+    void MapUnitSquareToTriangle2D(const double u[2],
+				   const double tA[2],
+				   const double tB[2],
+				   const double tC[2],
+				   double       p[2])
+    {
+	double a1 = u[0];
+	double a2 = u[1];
+
+	if(a1 + a2 > 1.0)
+	{
+	    a1 = 1 - a1;
+	    a2 = 1 - a2;
+	}
+
+	p[0] = tA[0] + a1 * (tB[0] - tA[0]) + a2 * (tC[0] - tA[0]);
+	p[1] = tA[1] + a1 * (tB[1] - tA[1]) + a2 * (tC[1] - tA[1]);
+    }
+
+    void MapUnitSquareToPolygon2D(const double u[2],
+				  Polygon2D * const poly,
+				  double p[2])
+    {
+	const std::vector<double> & areas = *(poly->GetTriangleAreas());
+	const int                   n     = areas.size();
+	const double                r     = u[0] * poly->GetArea();
+	double                      w     = 0;
+	double                      tri[6];
+	double                      v[2];
+	int                         t     = 0;
+
+	for(; t < n - 1 && w + areas[t] < r; ++t)
+	    w += areas[t];
+
+	v[0] = areas[t] > 0 ? (r - w) / areas[t] : 0;
+	v[0] = v[0] < 1 ? v[0] : 1;
+	v[1] = u[1];
+
+	poly->GetTriangleVertices(t, tri);
+	MapUnitSquareToTriangle2D(v, &tri[0], &tri[2], &tri[4], p);
+    }
+}
@@ -0,0 +1,118 @@
+#ifndef ABETARE__QUASI_RANDOM_HPP_
+#define ABETARE__QUASI_RANDOM_HPP_
+
+#include "Utils/Polygon2D.hpp"
+
+namespace Abetare
+{
+    /**
+     *@brief Low-discrepancy sequences of points in the unit square
+     *
+     *@par Description:
+     *  The points cover the square more evenly than independent
+     *  random points, without clumps and large empty regions, so fewer
+     *  of them are needed to reach every part of it. Point <em>i</em> is
+     *  computed from <em>i</em> alone, so threads can generate any part
+     *  of a sequence and the result does not depend on the global
+     *  generator of <em>PseudoRandom.hpp</em>.
+     *  \n\n
+     *  <em>HALTON</em> uses the radical inverses in bases 2 and 3.
+     *  <em>SOBOL</em> uses the first two Sobol dimensions, which
+     *  are stratified in every power-of-two block of points.
+     *  <em>R2</em> is the additive recurrence of Roberts,
+     *  <em>frac(1/2 + i * (1/g, 1/g^2))</em> with <em>g</em> the plastic
+     *  number, which is the cheapest and the most even for point counts
+     *  that are not powers of two.
+     *  \n\n
+     *  With a non-zero seed, the Sobol points are Owen scrambled with
+     *  the hash of Laine and Karras, and the Halton and R2 points are
+     *  shifted modulo 1 (Cranley-Patterson rotation), which keeps the
+     *  low discrepancy and gives independent sequences for different
+     *  seeds.
+     */
+    class QuasiRandom
+    {
+    public:
+	enum Sequence
+	    {
+		HALTON = 0,
+		SOBOL  = 1,
+		R2     = 2
+	    };
+
+	QuasiRandom(void)
+	{
+	    Setup(SOBOL);
+	}
+
+	virtual ~QuasiRandom(void)
+	{
+	}
+
+	virtual void Setup(const Sequence sequence, const unsigned long long seed = 0);
+
+	Sequence GetSequence(void) const
+	{
+	    return m_sequence;
+	}
+
+	/**
+	 *@brief Set <em>u</em> to point <em>i</em> of the sequence, in
+	 *       <em>[0, 1)^2</em>
+	 */
+	void GetPoint(const unsigned int i, double u[2]) const;
+
+	/**
+	 *@brief Set <em>u</em> to the point after the one of the previous
+	 *       call, starting from point 0 after <em>Setup</em>
+	 */
+	void Next(double u[2])
+	{
+	    GetPoint(m_index++, u);
+	}
+
+    protected:
+	Sequence     m_sequence;
+	unsigned int m_index;
+	bool         m_scramble;
+	unsigned int m_seeds[3];
+	double       m_shift[2];
+    };
+
+    /**
+     *@brief Map <em>u</em> in the unit square to <em>p</em> in the
+     *       box <em>[min, max]</em>
+     */
+    void MapUnitSquareToAABox2D(const double u[2],
+				const double min[2],
+				const double max[2],
+				double       p[2]);
+
+    /**
+     *@brief Map <em>u</em> in the unit square to <em>p</em> in the
+     *       triangle, folding it as <em>SampleRandomPointInsideTriangle2D</em>
+     *       does, so uniform points stay uniform
+     */
+    void MapUnitSquareToTriangle2D(const double u[2],
+				   const double tA[2],
+				   const double tB[2],
+				   const double tC[2],
+				   double       p[2]);
+
+    /**
+     *@brief Map <em>u</em> in the unit square to <em>p</em> in the
+     *       polygon
+     *
+     *@par Description:
+     *  <em>u[0]</em> selects a triangle of the triangulation with
+     *  probability proportional to its area, as
+     *  <em>Polygon2D::SelectTriangleBasedOnArea</em> does, and is
+     *  then rescaled to <em>[0, 1)</em> within the interval of that
+     *  triangle, so the point keeps the stratification of <em>u</em>.
+     */
+    void MapUnitSquareToPolygon2D(const double u[2],
+				  Polygon2D * const poly,
+				  double p[2]);
+}
+
+#endif
@@ -0,0 +1,94 @@
+#include "Utils/SceneOccupancy.hpp"
+#include "Utils/Parallel.hpp"
+#include <algorithm>
+
+namespace Abetare
+{
+    void SceneOccupancy::Compute(const Grid * const grid,
+				 const int          nrPolys,
+				 Polygon2D * const  polys[],
+				 const int          nrThreads)
+    {
+	const int ncells   = grid->GetNrCells();
+	int       nthreads = nrThreads <= 0 ? GetNrHardwareThreads() : nrThreads;
+
+	if(nthreads > nrPolys)
+	    nthreads = nrPolys > 0 ? nrPolys : 1;
+
+	//per thread: triples (cell, obstacle, inside)
+	std::vector< std::vector<int> > buffers(nthreads);
+
+	ParallelFor(nrPolys, nthreads, [&](const int i, const int t)
+		    {
+			std::vector<int>  inside;
+			std::vector<int>  intersect;
+			std::vector<int> *buffer = &(buffers[t]);
+
+			polys[i]->OccupiedGridCells(grid, &inside, &intersect);
+			for(int j = 0; j < (int) inside.size(); ++j)
+			{
+			    buffer->push_back(inside[j]);
+			    buffer->push_back(i);
+			    buffer->push_back(1);
+			}
+			for(int j = 0; j < (int) intersect.size(); ++j)
+			{
+			    buffer->push_back(intersect[j]);
+			    buffer->push_back(i);
+			    buffer->push_back(0);
+			}
+		    });
+
+	m_grid = grid;
+	m_cellStarts.assign(ncells + 1, 0);
+	m_inside.assign(ncells, 0);
+
+	for(int t = 0; t < nthreads; ++t)
+	    for(int j = 0; j < (int) buffers[t].size(); j += 3)
+		++m_cellStarts[buffers[t][j] + 1];
+	for(int i = 0; i < ncells; ++i)
+	    m_cellStarts[i + 1] += m_cellStarts[i];
+
+	std::vector<int> fill(m_cellStarts.begin(), m_cellStarts.end() - 1);
+
+	m_cellObstacles.resize(m_cellStarts[ncells]);
+	for(int t = 0; t < nthreads; ++t)
+	{
+	    const std::vector<int> *buffer = &(buffers[t]);
+	    const int               n      = buffer->size();
+
+	    for(int j = 0; j < n; j += 3)
+	    {
+		const int cell = (*buffer)[j];
+
+		m_cellObstacles[fill[cell]++] = (*buffer)[j + 1];
+		m_inside[cell] |= (*buffer)[j + 2];
+	    }
+	}
+
+	//threads pick obstacles dynamically, so restore a deterministic order
+	for(int i = 0; i < ncells; ++i)
+	    if(m_cellStarts[i + 1] - m_cellStarts[i] > 1)
+		std::sort(m_cellObstacles.begin() + m_cellStarts[i],
+			  m_cellObstacles.begin() + m_cellStarts[i + 1]);
+    }
+
+    int SceneOccupancy::GetNrOccupiedCells(void) const
+    {
+	const int n     = m_inside.size();
+	int       count = 0;
+
+	for(int i = 0; i < n; ++i)
+	    if(IsOccupied(i))
+		++count;
+	return count;
+    }
+
+    void SceneOccupancy::GetOccupied(bool occupied[]) const
+    {
+	const int n = m_inside.size();
+
+	for(int i = 0; i < n; ++i)
+	    occupied[i] = IsOccupied(i);
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef ABETARE__SCENE_OCCUPANCY_HPP_
+#define ABETARE__SCENE_OCCUPANCY_HPP_
+
+#include "Utils/Grid.hpp"
+#include "Utils/Polygon2D.hpp"
+#include <vector>
+
+namespace Abetare
+{
+    /**
+     *@brief Occupancy of a 2D grid by all the obstacles of a scene
+     *
+     *@par Description:
+     *  <em>Polygon2D::OccupiedGridCells</em> is computed for the
+     *  obstacles in parallel. Each thread appends its (cell, obstacle)
+     *  pairs to its own buffer; the buffers are then merged with a
+     *  counting sort into per-cell obstacle lists, so no locking is
+     *  needed.
+     */
+    class SceneOccupancy
+    {
+    public:
+	SceneOccupancy(void)
+	{
+	    m_grid = NULL;
+	}
+
+	virtual ~SceneOccupancy(void)
+	{
+	}
+
+	/**
+	 *@brief Compute the occupancy
+	 *
+	 *@param nrThreads number of threads (hardware threads if <= 0)
+	 */
+	virtual void Compute(const Grid * const grid,
+			     const int          nrPolys,
+			     Polygon2D * const  polys[],
+			     const int          nrThreads = 0);
+
+	const Grid* GetGrid(void) const
+	{
+	    return m_grid;
+	}
+
+	bool IsOccupied(const int id) const
+	{
+	    return m_cellStarts[id + 1] > m_cellStarts[id];
+	}
+
+	/**
+	 *@brief Returns true if the cell is fully inside some obstacle
+	 */
+	bool IsInside(const int id) const
+	{
+	    return m_inside[id] != 0;
+	}
+
+	/**
+	 *@brief Get the ids of the obstacles that are inside or intersect
+	 *       the cell, in increasing order
+	 */
+	const int* GetCellObstacles(const int id, int * const n) const
+	{
+	    *n = m_cellStarts[id + 1] - m_cellStarts[id];
+	    return m_cellObstacles.data() + m_cellStarts[id];
+	}
+
+	int GetNrOccupiedCells(void) const;
+
+	/**
+	 *@brief Fill <em>occupied[id]</em> for each grid cell, e.g., to
+	 *       build an <em>OccupancyPyramid2D</em>
+	 */
+	void GetOccupied(bool occupied[]) const;
+
+    protected:
+	const Grid                *m_grid;
+	std::vector<int>           m_cellStarts;
+	std::vector<int>           m_cellObstacles;
+	std::vector<unsigned char> m_inside;
+    };
+}
+
+#endif
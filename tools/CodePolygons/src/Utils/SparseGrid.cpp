@@ -0,0 +1,223 @@
+#include "Utils/SparseGrid.hpp"
+#include "Utils/Geometry.hpp"
+#include <cmath>
+
+namespace Abetare
+{
+    void SparseGrid::Setup(const int    ndims,
+			   const double units[],
+			   const double origin[])
+    {
+	m_ndims = ndims;
+	m_units.resize(ndims);
+	m_origin.resize(ndims);
+
+	m_cvol = 1;
+	for(int i = 0; i < ndims; ++i)
+	{
+	    m_units[i]  = units[i];
+	    m_origin[i] = origin[i];
+	    m_cvol     *= m_units[i];
+	}
+	m_cells.clear();
+    }
+
+    SparseGrid::CellKey SparseGrid::GetCellKeyFromCoords(const int coords[]) const
+    {
+	if(m_ndims == 2)
+	    return (CellKey) (((unsigned long long) (unsigned int) coords[0]) |
+			      (((unsigned long long) (unsigned int) coords[1]) << 32));
+
+	unsigned long long key = 0;
+	for(int i = m_ndims - 1; i >= 0; --i)
+	    key = (key << 21) | ((unsigned long long) (coords[i] + (1 << 20)) & 0x1fffff);
+	return (CellKey) key;
+    }
+
+    void SparseGrid::GetCoordsFromCellKey(const CellKey key, int coords[]) const
+    {
+	unsigned long long k = (unsigned long long) key;
+
+	if(m_ndims == 2)
+	{
+	    coords[0] = (int) (unsigned int) (k & 0xffffffffULL);
+	    coords[1] = (int) (unsigned int) (k >> 32);
+	    return;
+	}
+
+	for(int i = 0; i < m_ndims; ++i)
+	{
+	    coords[i] = ((int) (k & 0x1fffff)) - (1 << 20);
+	    k       >>= 21;
+	}
+    }
+
+    bool SparseGrid::GetCoords(const double p[], int coords[]) const
+    {
+	const int cmin = GetMinCoord();
+	const int cmax = GetMaxCoord();
+
+	for(int i = 0; i < m_ndims; ++i)
+	    if(!GetCoord(p[i], m_origin[i], m_units[i], cmin, cmax, &coords[i]))
+		return false;
+	return true;
+    }
+
+    bool SparseGrid::GetCellKey(const double p[], CellKey * const key) const
+    {
+	int coords[3];
+
+	if(!GetCoords(p, coords))
+	    return false;
+	*key = GetCellKeyFromCoords(coords);
+	return true;
+    }
+
+    void SparseGrid::GetCellFromCoords(const int coords[],
+				       double    min[],
+				       double    max[]) const
+    {
+	for(int i = 0; i < m_ndims; ++i)
+	{
+	    min[i] = m_origin[i] + m_units[i] * coords[i];
+	    max[i] = min[i]      + m_units[i];
+	}
+    }
+
+    void SparseGrid::GetCellFromKey(const CellKey key, double min[], double max[]) const
+    {
+	int coords[3];
+
+	GetCoordsFromCellKey(key, coords);
+	GetCellFromCoords(coords, min, max);
+    }
+
+    void SparseGrid::GetCellCenterFromCoords(const int coords[], double c[]) const
+    {
+	for(int i = 0; i < m_ndims; ++i)
+	    c[i] = m_origin[i] + (0.5 + coords[i]) * m_units[i];
+    }
+
+    void SparseGrid::GetCellCenterFromKey(const CellKey key, double c[]) const
+    {
+	int coords[3];
+
+	GetCoordsFromCellKey(key, coords);
+	GetCellCenterFromCoords(coords, c);
+    }
+
+    bool SparseGrid::IsPointInsideCell(const int coords[], const double p[]) const
+    {
+	double min;
+
+	for(int i = 0; i < m_ndims; ++i)
+	{
+	    min = m_origin[i] + m_units[i] * coords[i];
+	    if(p[i] < min || p[i] > (min + m_units[i]))
+		return false;
+	}
+	return true;
+    }
+
+    void SparseGrid::GetNeighs(const int coords[], std::vector<CellKey> * const neighs) const
+    {
+	const int cmin = GetMinCoord();
+	const int cmax = GetMaxCoord();
+	int       total = 1;
+	int       ncoords[3];
+
+	for(int i = 0; i < m_ndims; ++i)
+	    total *= 3;
+
+	for(int j = 0; j < total; ++j)
+	{
+	    bool valid = true;
+	    bool self  = true;
+
+	    for(int i = 0, f = j; i < m_ndims; ++i, f /= 3)
+	    {
+		const int d = (f % 3) - 1;
+
+		if((d < 0 && coords[i] == cmin) || (d > 0 && coords[i] == cmax))
+		    valid = false;
+		ncoords[i] = coords[i] + d;
+		self       = self && d == 0;
+	    }
+	    if(valid && !self)
+		neighs->push_back(GetCellKeyFromCoords(ncoords));
+	}
+    }
+
+    void SparseGrid::GetCellKeys(std::vector<CellKey> * const keys) const
+    {
+	for(std::unordered_map<CellKey, std::vector<int> >::const_iterator iter = m_cells.begin();
+	    iter != m_cells.end(); ++iter)
+	    keys->push_back(iter->first);
+    }
+
+    bool SparseGrid::RemoveItem(const CellKey key, const int item)
+    {
+	std::unordered_map<CellKey, std::vector<int> >::iterator iter = m_cells.find(key);
+
+	if(iter == m_cells.end())
+	    return false;
+
+	std::vector<int> *items = &(iter->second);
+	const int         n     = items->size();
+
+	for(int i = 0; i < n; ++i)
+	    if((*items)[i] == item)
+	    {
+		(*items)[i] = (*items)[n - 1];
+		items->pop_back();
+		if(items->empty())
+		    m_cells.erase(iter);
+		return true;
+	    }
+	return false;
+    }
+
+    bool SparseGrid::AddPoint(const int item, const double p[])
+    {
+	CellKey key;
+
+	if(!GetCellKey(p, &key))
+	    return false;
+	AddItem(key, item);
+	return true;
+    }
+
+    bool SparseGrid::AddPolygon(const int item, Polygon2D * const poly)
+    {
+	const double *bbox = poly->GetBoundingBox();
+	const int     n    = poly->m_vertices.size() / 2;
+	const double *v    = &(poly->m_vertices[0]);
+	int           coord_min[2];
+	int           coord_max[2];
+	int           coords[2];
+	double        min[2], max[2];
+	double        box[8];
+
+	if(!GetCoords(&bbox[0], coord_min) || !GetCoords(&bbox[2], coord_max))
+	    return false;
+
+	//64-bit counters, since the max coordinate can be INT_MAX
+	for(long long x = coord_min[0]; x <= coord_max[0]; ++x)
+	{
+	    coords[0] = (int) x;
+	    for(long long y = coord_min[1]; y <= coord_max[1]; ++y)
+	    {
+		coords[1] = (int) y;
+
+		GetCellFromCoords(coords, min, max);
+		AABoxAsPolygon2D(min, max, box);
+
+		if(IntersectPolygons2D(4, box, n, v) ||
+		   IsPolygonInsidePolygon2D(4, box, n, v, false) ||
+		   IsPolygonInsideConvexPolygon2D(n, v, 4, box))
+		    AddItem(GetCellKeyFromCoords(coords), item);
+	    }
+	}
+	return true;
+    }
+}
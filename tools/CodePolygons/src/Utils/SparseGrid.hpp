@@ -0,0 +1,202 @@
+#ifndef ABETARE__SPARSE_GRID_HPP_
+#define ABETARE__SPARSE_GRID_HPP_
+
+#include "Utils/Polygon2D.hpp"
+#include <vector>
+#include <unordered_map>
+#include <cmath>
+
+namespace Abetare
+{
+    /**
+     *@brief Unbounded grid that allocates only the cells that store items
+     *
+     *@par Description:
+     *  Cells have fixed sides <em>units</em> and are aligned with
+     *  <em>origin</em>, but there are no min/max bounds. Cell
+     *  coordinates are packed into a 64-bit key (32 bits per dimension
+     *  in 2D, 21 bits per dimension in 3D) and cells are kept in a hash
+     *  table, so memory is proportional to the number of non-empty
+     *  cells. Points whose coordinates do not fit in the key are
+     *  reported as out of range rather than clamped. Up to three
+     *  dimensions are supported.
+     */
+    class SparseGrid
+    {
+    public:
+	SparseGrid(void)
+	{
+	    m_ndims = 0;
+	    m_cvol  = 0;
+	}
+
+	virtual ~SparseGrid(void)
+	{
+	}
+
+	typedef long long CellKey;
+
+	virtual void Setup2D(const double unitX, const double unitY,
+			     const double originX = 0, const double originY = 0)
+	{
+	    const double units[2] =
+		{
+		    unitX, unitY
+		};
+	    const double origin[2] =
+		{
+		    originX, originY
+		};
+	    Setup(2, units, origin);
+	}
+
+	virtual void Setup(const int    ndims,
+			   const double units[],
+			   const double origin[]);
+
+	int GetNrDims(void) const
+	{
+	    return m_ndims;
+	}
+
+	const double* GetOrigin(void) const
+	{
+	    return &(m_origin[0]);
+	}
+
+	const double* GetUnits(void) const
+	{
+	    return &(m_units[0]);
+	}
+
+	double GetCellVolume(void) const
+	{
+	    return m_cvol;
+	}
+
+	int GetMinCoord(void) const
+	{
+	    return m_ndims == 2 ? -2147483647 - 1 : -(1 << 20);
+	}
+
+	int GetMaxCoord(void) const
+	{
+	    return m_ndims == 2 ? 2147483647 : (1 << 20) - 1;
+	}
+
+	virtual CellKey GetCellKeyFromCoords(const int coords[]) const;
+
+	virtual void GetCoordsFromCellKey(const CellKey key, int coords[]) const;
+
+	/**
+	 *@brief Compute the cell coordinates of <em>p</em>
+	 *
+	 *@returns false if a coordinate does not fit in a cell key
+	 */
+	virtual bool GetCoords(const double p[], int coords[]) const;
+
+	/**
+	 *@brief Compute the key of the cell that contains <em>p</em>
+	 *
+	 *@returns false if <em>p</em> is out of the representable range
+	 */
+	virtual bool GetCellKey(const double p[], CellKey * const key) const;
+
+	virtual void GetCellFromCoords(const int coords[],
+				       double    min[],
+				       double    max[]) const;
+
+	virtual void GetCellFromKey(const CellKey key, double min[], double max[]) const;
+
+	virtual void GetCellCenterFromCoords(const int coords[], double c[]) const;
+
+	virtual void GetCellCenterFromKey(const CellKey key, double c[]) const;
+
+	virtual bool IsPointInsideCell(const int coords[], const double p[]) const;
+
+	/**
+	 *@brief Get the keys of all the cells adjacent to the given cell,
+	 *       whether or not they are allocated
+	 */
+	virtual void GetNeighs(const int coords[], std::vector<CellKey> * const neighs) const;
+
+	int GetNrCells(void) const
+	{
+	    return m_cells.size();
+	}
+
+	bool HasCell(const CellKey key) const
+	{
+	    return m_cells.find(key) != m_cells.end();
+	}
+
+	/**
+	 *@brief Get the items stored in the cell or NULL if the cell is
+	 *       not allocated
+	 */
+	const std::vector<int>* GetCellItems(const CellKey key) const
+	{
+	    std::unordered_map<CellKey, std::vector<int> >::const_iterator iter = m_cells.find(key);
+
+	    return iter == m_cells.end() ? NULL : &(iter->second);
+	}
+
+	void GetCellKeys(std::vector<CellKey> * const keys) const;
+
+	void AddItem(const CellKey key, const int item)
+	{
+	    m_cells[key].push_back(item);
+	}
+
+	/**
+	 *@brief Remove <em>item</em> from the cell, releasing the cell
+	 *       when it becomes empty
+	 */
+	bool RemoveItem(const CellKey key, const int item);
+
+	/**
+	 *@brief Store <em>item</em> in the cell that contains <em>p</em>
+	 *
+	 *@returns false if <em>p</em> is out of range
+	 */
+	bool AddPoint(const int item, const double p[]);
+
+	/**
+	 *@brief Store <em>item</em> in every cell that is inside or
+	 *       intersects the polygon
+	 *
+	 *@returns false if the polygon bounding box is out of range
+	 */
+	bool AddPolygon(const int item, Polygon2D * const poly);
+
+	void Clear(void)
+	{
+	    m_cells.clear();
+	}
+
+    protected:
+	static bool GetCoord(const double x,
+			     const double origin,
+			     const double unit,
+			     const int    cmin,
+			     const int    cmax,
+			     int * const  c)
+	{
+	    const double f = floor((x - origin) / unit);
+
+	    if(!(f >= cmin && f <= cmax))
+		return false;
+	    *c = (int) f;
+	    return true;
+	}
+
+	int                 m_ndims;
+	std::vector<double> m_origin;
+	std::vector<double> m_units;
+	double              m_cvol;
+
+	std::unordered_map<CellKey, std::vector<int> > m_cells;
+    };
+}
+
+#endif
@@ -0,0 +1,194 @@
+#include "Utils/ThetaStar.hpp"
+#include "Utils/Misc.hpp"
+#include <cstdlib>
+
+namespace Abetare
+{
+    void ThetaStar::Setup(const GridSearchInfo * const info, const int logCacheSize)
+    {
+	const int n = info->GetDimX() * info->GetDimY();
+
+	m_info = info;
+	m_dimX = info->GetDimX();
+	m_parents.resize(n);
+	m_gCosts.resize(n);
+	m_stamps.assign(n, 0);
+	m_closed.assign(n, 0);
+	m_stamp = 0;
+	m_heap.Setup(n);
+
+	//a shift by 64 is undefined, and so is 1 << 31
+	const int logSize = logCacheSize < 1 ? 1 : (logCacheSize > 30 ? 30 : logCacheSize);
+
+	m_cache.resize(1 << logSize);
+	m_cacheShift = 64 - logSize;
+	InvalidateCache();
+    }
+
+    void ThetaStar::InvalidateCache(void)
+    {
+	if(++m_cacheStamp == 0)
+	{
+	    for(int i = 0; i < (int) m_cache.size(); ++i)
+		m_cache[i].m_stamp = 0;
+	    m_cacheStamp = 1;
+	}
+    }
+
+    bool ThetaStar::ComputeLineOfSight(const int u, const int v) const
+    {
+	const int x1    = v % m_dimX;
+	const int y1    = v / m_dimX;
+	const int sx    = x1 > u % m_dimX ? 1 : -1;
+	const int sy    = y1 > u / m_dimX ? 1 : -1;
+	const int dx    = 2 * abs(x1 - u % m_dimX);
+	const int dy    = 2 * abs(y1 - u / m_dimX);
+	int       x     = u % m_dimX;
+	int       y     = u / m_dimX;
+	int       error = (dx - dy) / 2;
+
+	if(!m_info->IsFree(x, y))
+	    return false;
+
+	//error is the side of the next cell corner relative to the segment
+	for(int n = (dx + dy) / 2; n > 0; --n)
+	{
+	    if(error > 0)
+	    {
+		x     += sx;
+		error -= dy;
+	    }
+	    else if(error < 0)
+	    {
+		y     += sy;
+		error += dx;
+	    }
+	    else
+	    {
+		//through a corner: both cells by it must be free
+		if(!m_info->IsFree(x + sx, y) || !m_info->IsFree(x, y + sy))
+		    return false;
+		x     += sx;
+		y     += sy;
+		error += dx - dy;
+		--n;
+	    }
+	    if(!m_info->IsFree(x, y))
+		return false;
+	}
+
+	return true;
+    }
+
+    bool ThetaStar::LineOfSight(const int u, const int v)
+    {
+	const unsigned long long key =
+	    u < v ? ((unsigned long long) u << 32) | v : ((unsigned long long) v << 32) | u;
+	CacheEntry & entry = m_cache[(key * 0x9E3779B97F4A7C15ULL) >> m_cacheShift];
+
+	++m_nrChecks;
+	if(entry.m_stamp == m_cacheStamp && entry.m_key == key)
+	{
+	    ++m_nrCacheHits;
+	    return entry.m_visible;
+	}
+
+	entry.m_key     = key;
+	entry.m_stamp   = m_cacheStamp;
+	entry.m_visible = ComputeLineOfSight(u, v);
+
+	return entry.m_visible;
+    }
+
+    void ThetaStar::SetVertex(const int u)
+    {
+	if(LineOfSight(m_parents[u], u))
+	    return;
+
+	//u was generated by an expanded neighbor, so there is one
+	m_edges.clear();
+	m_costs.clear();
+	m_info->GetOutEdges(u, &m_edges, &m_costs);
+	m_gCosts[u] = HUGE_VAL;
+	for(int i = 0; i < (int) m_edges.size(); ++i)
+	{
+	    const int w = m_edges[i];
+
+	    if(m_closed[w] == m_stamp && m_gCosts[w] + m_costs[i] < m_gCosts[u])
+	    {
+		m_parents[u] = w;
+		m_gCosts[u]  = m_gCosts[w] + m_costs[i];
+	    }
+	}
+    }
+
+    bool ThetaStar::Search(const int start, const int goal)
+    {
+	m_heap.Clear();
+	if(++m_stamp == 0)
+	{
+	    m_stamps.assign(m_stamps.size(), 0);
+	    m_closed.assign(m_closed.size(), 0);
+	    m_stamp = 1;
+	}
+	m_goal         = goal;
+	m_nrExpansions = 0;
+	m_nrChecks     = 0;
+	m_nrCacheHits  = 0;
+
+	m_stamps[start]  = m_stamp;
+	m_parents[start] = start;
+	m_gCosts[start]  = 0;
+	m_heap.Insert(start, Distance(start, goal));
+
+	while(!m_heap.IsEmpty())
+	{
+	    const int u = m_heap.RemoveTop();
+
+	    if(m_lazy && u != start)
+		SetVertex(u);
+	    m_closed[u] = m_stamp;
+	    ++m_nrExpansions;
+	    if(u == goal)
+		return true;
+
+	    const int    p  = m_parents[u];
+	    const double gp = m_gCosts[p];
+
+	    m_edges.clear();
+	    m_costs.clear();
+	    m_info->GetOutEdges(u, &m_edges, &m_costs);
+	    for(int i = 0; i < (int) m_edges.size(); ++i)
+	    {
+		const int v = m_edges[i];
+
+		if(m_closed[v] == m_stamp)
+		    continue;
+
+		//Lazy Theta* checks the line of sight from p when v is expanded
+		if(p != u && (m_lazy || LineOfSight(p, v)))
+		    Visit(v, p, gp + Distance(p, v));
+		else
+		    Visit(v, u, m_gCosts[u] + m_costs[i]);
+	    }
+	}
+
+	return false;
+    }
+
+    void ThetaStar::GetPathFromStart(const int u, std::vector<int> * const path) const
+    {
+	if(m_stamps[u] != m_stamp)
+	    return;
+
+	const int first = path->size();
+
+	for(int v = u; ; v = m_parents[v])
+	{
+	    path->push_back(v);
+	    if(m_parents[v] == v)
+		break;
+	}
+	ReverseItems<int>(path->size() - first, &((*path)[first]));
+    }
+}
@@ -0,0 +1,173 @@
+#ifndef ABETARE__THETA_STAR_HPP_
+#define ABETARE__THETA_STAR_HPP_
+
+#include "Utils/GridSearchInfo.hpp"
+#include "Utils/DaryHeap.hpp"
+#include <vector>
+#include <cmath>
+
+namespace Abetare
+{
+    /**
+     *@brief Any-angle search (Theta* and Lazy Theta*) over the free
+     *       cells of a 2D grid
+     *
+     *@par Description:
+     *  Same expansions as A* over <em>GridSearchInfo</em>, but the
+     *  parent of a cell may be any cell in line of sight, not only a
+     *  neighbor, so paths go straight between the cell centers where
+     *  they turn and need no smoothing afterwards. Costs are Euclidean
+     *  distances in cell units, so path costs are at most those of the
+     *  8-connected grid.
+     *  \n\n
+     *  Theta* checks the line of sight from the parent of <em>u</em>
+     *  to each neighbor of <em>u</em> when it is generated. Lazy Theta*
+     *  assumes it and checks it once when the neighbor is expanded,
+     *  which is far fewer checks.
+     *  \n\n
+     *  Line of sight follows all the cells crossed by the segment
+     *  between the two centers; when the segment passes through a
+     *  corner, both cells by the corner must be free, as for diagonal
+     *  moves on the grid. Results are kept in a direct-mapped cache that
+     *  persists across searches, so it has to be cleared with
+     *  <em>InvalidateCache</em> when the occupancy changes.
+     */
+    class ThetaStar
+    {
+    public:
+	ThetaStar(void)
+	{
+	    m_info         = NULL;
+	    m_lazy         = true;
+	    m_stamp        = 0;
+	    m_cacheStamp   = 1;
+	    m_nrExpansions = 0;
+	    m_nrChecks     = 0;
+	    m_nrCacheHits  = 0;
+	}
+
+	virtual ~ThetaStar(void)
+	{
+	}
+
+	/**
+	 *@brief Use Lazy Theta* instead of Theta*
+	 */
+	bool m_lazy;
+
+	/**
+	 *@brief Allocate the search arrays for the grid of <em>info</em>
+	 *       and a line-of-sight cache of <em>2^logCacheSize</em> entries
+	 *
+	 *@param logCacheSize clamped to <em>[1, 30]</em>
+	 */
+	virtual void Setup(const GridSearchInfo * const info, const int logCacheSize = 14);
+
+	bool Search(const int start, const int goal);
+
+	/**
+	 *@brief Returns true if the segment between the centers of cells
+	 *       <em>u</em> and <em>v</em> crosses free cells only
+	 */
+	bool LineOfSight(const int u, const int v);
+
+	/**
+	 *@brief Forget the cached line-of-sight results
+	 */
+	void InvalidateCache(void);
+
+	/**
+	 *@brief Get the cells where the path turns, from the start to
+	 *       <em>u</em>
+	 */
+	void GetPathFromStart(const int u, std::vector<int> * const path) const;
+
+	double GetPathCostFromStart(const int u) const
+	{
+	    return m_stamps[u] == m_stamp ? m_gCosts[u] : HUGE_VAL;
+	}
+
+	int GetNrExpansions(void) const
+	{
+	    return m_nrExpansions;
+	}
+
+	/**
+	 *@brief Number of line-of-sight tests by the last search and how
+	 *       many of them were answered by the cache
+	 */
+	int GetNrLineOfSightChecks(void) const
+	{
+	    return m_nrChecks;
+	}
+
+	int GetNrCacheHits(void) const
+	{
+	    return m_nrCacheHits;
+	}
+
+	double Distance(const int u, const int v) const
+	{
+	    const int dx = u % m_dimX - v % m_dimX;
+	    const int dy = u / m_dimX - v / m_dimX;
+
+	    return sqrt((double) (dx * dx + dy * dy));
+	}
+
+    protected:
+	/**
+	 *@brief Supercover traversal of the segment between the centers
+	 */
+	bool ComputeLineOfSight(const int u, const int v) const;
+
+	/**
+	 *@brief Lazy Theta*: when <em>u</em> is not in line of sight of
+	 *       its parent, take the best expanded neighbor as parent
+	 */
+	void SetVertex(const int u);
+
+	void Visit(const int v, const int parent, const double g)
+	{
+	    if(m_stamps[v] != m_stamp)
+	    {
+		m_stamps[v]  = m_stamp;
+		m_parents[v] = parent;
+		m_gCosts[v]  = g;
+		m_heap.Insert(v, g + Distance(v, m_goal));
+	    }
+	    else if(g < m_gCosts[v])
+	    {
+		m_parents[v] = parent;
+		m_gCosts[v]  = g;
+		m_heap.InsertOrUpdate(v, g + Distance(v, m_goal));
+	    }
+	}
+
+	struct CacheEntry
+	{
+	    unsigned long long m_key;
+	    unsigned int       m_stamp;
+	    bool               m_visible;
+	};
+
+	const GridSearchInfo     *m_info;
+	int                       m_dimX;
+	int                       m_goal;
+	std::vector<int>          m_parents;
+	std::vector<double>       m_gCosts;
+	std::vector<unsigned int> m_stamps;
+	std::vector<unsigned int> m_closed;
+	unsigned int              m_stamp;
+	DaryHeap<4>               m_heap;
+	std::vector<int>          m_edges;
+	std::vector<double>       m_costs;
+	std::vector<CacheEntry>   m_cache;
+	int                       m_cacheShift;
+	unsigned int              m_cacheStamp;
+	int                       m_nrExpansions;
+	int                       m_nrChecks;
+	int                       m_nrCacheHits;
+    };
+}
+
+#endif